@@ -0,0 +1,26 @@
+﻿/**
+ * File:   stress_assets.c
+ * Author: AWTK Develop Team
+ * Brief:  压力测试使用的资源。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#include "awtk.h"
+
+/*和 demo 的 app_main.c 一样，使用 update_res.py 生成的资源*/
+#include "../../res/assets.inc"
@@ -0,0 +1,379 @@
+﻿/**
+ * File:   stress_demo.c
+ * Author: AWTK Develop Team
+ * Brief:  大量进度条的压力测试。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#include <math.h>
+#include <stdio.h>
+#include "awtk.h"
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "progress_polygon/polygon_pool.h"
+#include "progress_polygon/progress_polygon.h"
+#include "progress_polygon/progress_polygon_group.h"
+#include "stress_demo.h"
+
+/*MSVC 的 math.h 默认不定义 M_PI*/
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif /*M_PI*/
+
+#define STRESS_DEMO_MARGIN 1
+#define STRESS_DEMO_BAR_WIDTH 40
+#define STRESS_DEMO_HISTOGRAM_NR 10
+
+static uint32_t stress_demo_random(stress_demo_t* demo) {
+  /*xorshift32，不同平台上得到相同的序列*/
+  uint32_t x = demo->seed;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  demo->seed = x;
+
+  return x;
+}
+
+static char* stress_demo_make_arc(uint32_t n) {
+  uint32_t i = 0;
+  str_t str;
+
+  /*上半个椭圆环，铺满控件*/
+  str_init(&str, n * 48);
+  for (i = 0; i < n; i++) {
+    double v = (double)i / (n - 1);
+    double a = v * M_PI;
+    str_append_format(&str, 64, "(%.4f,%.4f,%.4f,%.4f,%.4f)", v, 0.5 - 0.5 * cos(a),
+                      1 - sin(a), 0.5 - 0.25 * cos(a), 1 - 0.5 * sin(a));
+  }
+
+  return str.str;
+}
+
+static widget_t* stress_demo_create_gauge(stress_demo_t* demo, const char** polygons, xy_t x,
+                                          xy_t y, wh_t w, wh_t h) {
+  uint32_t r = stress_demo_random(demo) % 100;
+  widget_t* gauge = progress_polygon_create(demo->container, x, y, w, h);
+  return_value_if_fail(gauge != NULL, NULL);
+
+  /*点数: 2(矩形/三角形) 40%，16 30%，64 20%，512 10%*/
+  if (r < 20) {
+    progress_polygon_set_polygon(gauge, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  } else if (r < 40) {
+    progress_polygon_set_polygon(gauge, "(0, 0,1,0,1)(1, 1,0,1,1)");
+  } else {
+    progress_polygon_set_polygon(gauge, polygons[r < 70 ? 0 : (r < 90 ? 1 : 2)]);
+  }
+
+  /*填充方式: 纯色 40%，无边框纯色 30%，渐变色 10%，图片 10%，区间 10%*/
+  r = stress_demo_random(demo) % 100;
+  if (r >= 40 && r < 70) {
+    widget_use_style(gauge, "flat");
+  } else if (r >= 70 && r < 80) {
+    widget_use_style(gauge, "gradient");
+  } else if (r >= 80 && r < 90) {
+    widget_use_style(gauge, "image");
+  } else if (r >= 90) {
+    progress_polygon_set_start_value(gauge, stress_demo_random(demo) % 50);
+  }
+  progress_polygon_set_value(gauge, stress_demo_random(demo) % 101);
+
+  return gauge;
+}
+
+stress_demo_t* stress_demo_create(widget_t* parent, uint32_t n, bool_t group, uint32_t seed) {
+  uint32_t i = 0;
+  uint32_t cols = 0;
+  uint32_t rows = 0;
+  wh_t cell_w = 0;
+  wh_t cell_h = 0;
+  char* polygons[3];
+  stress_demo_t* demo = NULL;
+  return_value_if_fail(parent != NULL && parent->w > 0 && parent->h > 0, NULL);
+
+  demo = TKMEM_ZALLOC(stress_demo_t);
+  return_value_if_fail(demo != NULL, NULL);
+
+  n = tk_clamp(n, STRESS_DEMO_MIN_NR, STRESS_DEMO_MAX_NR);
+  demo->seed = seed != 0 ? seed : 1;
+  demo->gauges_nr = n;
+  if (group) {
+    demo->container = progress_polygon_group_create(parent, 0, 0, parent->w, parent->h);
+  } else {
+    demo->container = view_create(parent, 0, 0, parent->w, parent->h);
+  }
+
+  /*网格的宽高比与父控件相同*/
+  cols = (uint32_t)ceil(sqrt((double)n * parent->w / parent->h));
+  rows = (n + cols - 1) / cols;
+  cell_w = tk_max(parent->w / cols, 2 * STRESS_DEMO_MARGIN + 1);
+  cell_h = tk_max(parent->h / rows, 2 * STRESS_DEMO_MARGIN + 1);
+
+  polygons[0] = stress_demo_make_arc(16);
+  polygons[1] = stress_demo_make_arc(64);
+  polygons[2] = stress_demo_make_arc(512);
+  for (i = 0; i < n; i++) {
+    stress_demo_create_gauge(demo, (const char**)polygons,
+                             (i % cols) * cell_w + STRESS_DEMO_MARGIN,
+                             (i / cols) * cell_h + STRESS_DEMO_MARGIN,
+                             cell_w - 2 * STRESS_DEMO_MARGIN, cell_h - 2 * STRESS_DEMO_MARGIN);
+  }
+  TKMEM_FREE(polygons[0]);
+  TKMEM_FREE(polygons[1]);
+  TKMEM_FREE(polygons[2]);
+
+  return demo;
+}
+
+ret_t stress_demo_update(stress_demo_t* demo) {
+  uint64_t start = time_now_us();
+  return_value_if_fail(demo != NULL && demo->container != NULL, RET_BAD_PARAMS);
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(demo->container, iter, i)
+  progress_polygon_set_value(iter, stress_demo_random(demo) % 101);
+  WIDGET_FOR_EACH_CHILD_END();
+  demo->update_time += time_now_us() - start;
+
+  return RET_OK;
+}
+
+ret_t stress_demo_paint_begin(stress_demo_t* demo) {
+  return_value_if_fail(demo != NULL, RET_BAD_PARAMS);
+
+  demo->paint_start = time_now_us();
+
+  return RET_OK;
+}
+
+static ret_t stress_demo_sample_mem(stress_demo_t* demo) {
+  uint32_t used = 0;
+  polygon_pool_stat_t stat;
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(demo->container, iter, i)
+  used += progress_polygon_get_mem_size(iter);
+  WIDGET_FOR_EACH_CHILD_END();
+  demo->peak_gauges_mem = tk_max(demo->peak_gauges_mem, used);
+
+  if (polygon_pool_get_stat(&stat) == RET_OK) {
+    demo->peak_pool_mem = tk_max(demo->peak_pool_mem, stat.reserved);
+  }
+
+  return RET_OK;
+}
+
+ret_t stress_demo_paint_end(stress_demo_t* demo) {
+  uint64_t paint = 0;
+  return_value_if_fail(demo != NULL, RET_BAD_PARAMS);
+
+  paint = time_now_us() - demo->paint_start;
+  if (demo->frames_nr >= demo->frames_capacity) {
+    uint32_t capacity = demo->frames_capacity > 0 ? demo->frames_capacity * 2 : 256;
+    uint32_t* frame_times = TKMEM_REALLOCT(uint32_t, demo->frame_times, capacity);
+    return_value_if_fail(frame_times != NULL, RET_OOM);
+
+    demo->frame_times = frame_times;
+    demo->frames_capacity = capacity;
+  }
+
+  demo->paint_time += paint;
+  demo->frame_times[demo->frames_nr++] = (uint32_t)(demo->update_time + paint);
+  demo->update_time = 0;
+
+  /*不计入帧时间*/
+  return stress_demo_sample_mem(demo);
+}
+
+static int stress_demo_compare(const void* a, const void* b) {
+  uint32_t ua = *(const uint32_t*)a;
+  uint32_t ub = *(const uint32_t*)b;
+
+  return ua < ub ? -1 : (ua > ub ? 1 : 0);
+}
+
+static double stress_demo_percentile(const uint32_t* sorted, uint32_t nr, uint32_t percent) {
+  /*nearest-rank*/
+  uint32_t rank = (nr * percent + 99) / 100;
+
+  return sorted[rank > 0 ? rank - 1 : 0] / 1000.0;
+}
+
+static uint32_t stress_demo_get_peak_rss(void) {
+  uint32_t kb = 0;
+#ifdef LINUX
+  char line[128];
+  FILE* fp = fopen("/proc/self/status", "r");
+
+  if (fp != NULL) {
+    while (fgets(line, sizeof(line), fp) != NULL) {
+      if (strncmp(line, "VmHWM:", 6) == 0) {
+        kb = tk_atoi(line + 6);
+        break;
+      }
+    }
+    fclose(fp);
+  }
+#endif /*LINUX*/
+
+  return kb;
+}
+
+ret_t stress_demo_report(stress_demo_t* demo, str_t* str) {
+  uint32_t i = 0;
+  uint32_t nr = 0;
+  uint32_t max_count = 0;
+  uint32_t batched = 0;
+  uint32_t styles = 0;
+  uint32_t* sorted = NULL;
+  uint32_t counts[STRESS_DEMO_HISTOGRAM_NR];
+  return_value_if_fail(demo != NULL && str != NULL, RET_BAD_PARAMS);
+
+  nr = demo->frames_nr;
+  str_append_format(str, 128, "gauges: %u (%s)\n", demo->gauges_nr,
+                    widget_get_type(demo->container));
+  if (WIDGET_IS_INSTANCE_OF(demo->container, progress_polygon_group) &&
+      progress_polygon_group_get_stat(demo->container, &batched, &styles) == RET_OK) {
+    str_append_format(str, 128, "batched: %u gauges in %u styles\n", batched, styles);
+  }
+
+  if (nr == 0) {
+    return str_append(str, "no frame painted\n");
+  }
+
+  sorted = TKMEM_ZALLOCN(uint32_t, nr);
+  return_value_if_fail(sorted != NULL, RET_OOM);
+  memcpy(sorted, demo->frame_times, nr * sizeof(uint32_t));
+  qsort(sorted, nr, sizeof(uint32_t), stress_demo_compare);
+
+  str_append_format(str, 128, "frames: %u, first frame: %.2f ms\n", nr,
+                    demo->frame_times[0] / 1000.0);
+  str_append_format(str, 128, "total paint time: %.2f ms (%.3f ms/frame)\n",
+                    demo->paint_time / 1000.0, demo->paint_time / 1000.0 / nr);
+  str_append_format(str, 128, "frame time p50/p95/p99/max: %.3f/%.3f/%.3f/%.3f ms\n",
+                    stress_demo_percentile(sorted, nr, 50), stress_demo_percentile(sorted, nr, 95),
+                    stress_demo_percentile(sorted, nr, 99), sorted[nr - 1] / 1000.0);
+
+  /*按 2 的幂分桶: <1ms, <2ms, <4ms ... 最后一个桶包括更大的*/
+  memset(counts, 0x00, sizeof(counts));
+  for (i = 0; i < nr; i++) {
+    uint32_t bucket = 0;
+    uint32_t limit = 1000;
+
+    while (bucket + 1 < STRESS_DEMO_HISTOGRAM_NR && sorted[i] >= limit) {
+      bucket++;
+      limit *= 2;
+    }
+    counts[bucket]++;
+    max_count = tk_max(max_count, counts[bucket]);
+  }
+
+  str_append(str, "frame time histogram:\n");
+  for (i = 0; i < STRESS_DEMO_HISTOGRAM_NR; i++) {
+    uint32_t j = 0;
+    uint32_t bar = counts[i] * STRESS_DEMO_BAR_WIDTH / max_count;
+
+    if (i + 1 < STRESS_DEMO_HISTOGRAM_NR) {
+      str_append_format(str, 64, "  < %4u ms %6u ", 1u << i, counts[i]);
+    } else {
+      str_append_format(str, 64, "  >=%4u ms %6u ", 1u << (i - 1), counts[i]);
+    }
+    for (j = 0; j < bar; j++) {
+      str_append_char(str, '#');
+    }
+    str_append_char(str, '\n');
+  }
+
+  str_append_format(str, 128, "peak memory: gauges %u KB, pool %u KB, rss %u KB\n",
+                    demo->peak_gauges_mem / 1024, demo->peak_pool_mem / 1024,
+                    stress_demo_get_peak_rss());
+  TKMEM_FREE(sorted);
+
+  return RET_OK;
+}
+
+ret_t stress_demo_destroy(stress_demo_t* demo) {
+  return_value_if_fail(demo != NULL, RET_BAD_PARAMS);
+
+  TKMEM_FREE(demo->frame_times);
+  TKMEM_FREE(demo);
+
+  return RET_OK;
+}
+
+static ret_t stress_demo_on_timer(const timer_info_t* info) {
+  stress_demo_t* demo = (stress_demo_t*)(info->ctx);
+
+  stress_demo_update(demo);
+
+  return RET_REPEAT;
+}
+
+static ret_t stress_demo_on_before_paint(void* ctx, event_t* e) {
+  return stress_demo_paint_begin((stress_demo_t*)ctx);
+}
+
+static ret_t stress_demo_on_after_paint(void* ctx, event_t* e) {
+  return stress_demo_paint_end((stress_demo_t*)ctx);
+}
+
+static ret_t stress_demo_on_destroy(void* ctx, event_t* e) {
+  str_t str;
+  stress_demo_t* demo = (stress_demo_t*)ctx;
+
+  str_init(&str, 1024);
+  stress_demo_report(demo, &str);
+  log_debug("%s", str.str);
+  str_reset(&str);
+  stress_demo_destroy(demo);
+
+  return RET_REMOVE;
+}
+
+static ret_t stress_demo_on_close(void* ctx, event_t* e) {
+  return window_close(WIDGET(ctx));
+}
+
+ret_t stress_demo_open(uint32_t n, bool_t group) {
+  widget_t* close = NULL;
+  stress_demo_t* demo = NULL;
+  widget_t* wm = window_manager();
+  widget_t* win = window_create(NULL, 0, 0, wm->w, wm->h);
+  return_value_if_fail(win != NULL, RET_OOM);
+
+  widget_set_prop_str(win, WIDGET_PROP_THEME, "main");
+  demo = stress_demo_create(win, n, group, (uint32_t)time_now_ms());
+  if (demo == NULL) {
+    window_close(win);
+    return RET_OOM;
+  }
+
+  close = button_create(win, 0, 0, 0, 0);
+  widget_set_text_utf8(close, "Close");
+  widget_set_self_layout_params(close, "r:10", "b:10", "80", "30");
+  widget_set_floating(close, TRUE);
+  widget_on(close, EVT_CLICK, stress_demo_on_close, win);
+
+  widget_on(win, EVT_BEFORE_PAINT, stress_demo_on_before_paint, demo);
+  widget_on(win, EVT_AFTER_PAINT, stress_demo_on_after_paint, demo);
+  widget_on(win, EVT_DESTROY, stress_demo_on_destroy, demo);
+  widget_add_timer(win, stress_demo_on_timer, 16);
+
+  return RET_OK;
+}
@@ -0,0 +1,136 @@
+﻿/**
+ * File:   stress_demo.h
+ * Author: AWTK Develop Team
+ * Brief:  大量进度条的压力测试。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#ifndef TK_STRESS_DEMO_H
+#define TK_STRESS_DEMO_H
+
+#include "tkc/str.h"
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+#define STRESS_DEMO_MIN_NR 10
+#define STRESS_DEMO_MAX_NR 5000
+#define STRESS_DEMO_DEFAULT_NR 500
+
+/**
+ * @class stress_demo_t
+ * 大量进度条的压力测试。
+ *
+ * 按网格创建 N 个进度条，混合不同的点数(2/16/64/512)和填充方式(纯色、无边框纯色、渐变色、图片、区间)，
+ * 每一帧随机修改全部进度条的值，并统计帧时间的分布、总的绘制时间和内存的峰值。
+ */
+typedef struct _stress_demo_t {
+  /**
+   * @property {widget_t*} container
+   * 进度条的父控件(progress\_polygon\_group 或 view)。
+   */
+  widget_t* container;
+  /**
+   * @property {uint32_t} gauges_nr
+   * 进度条的个数。
+   */
+  uint32_t gauges_nr;
+
+  /*private*/
+  uint32_t seed;
+  uint64_t update_time;
+  uint64_t paint_start;
+  uint64_t paint_time;
+  uint32_t frames_nr;
+  uint32_t frames_capacity;
+  uint32_t* frame_times;
+  uint32_t peak_gauges_mem;
+  uint32_t peak_pool_mem;
+} stress_demo_t;
+
+/**
+ * @method stress_demo_create
+ * 在 parent 中创建 n 个进度条。
+ * @param {widget_t*} parent 父控件(一般为窗口，进度条铺满它)。
+ * @param {uint32_t} n 进度条的个数(10-5000)。
+ * @param {bool_t} group 是否放到 progress\_polygon\_group 中合并绘制。
+ * @param {uint32_t} seed 随机数的种子(相同的种子得到相同的界面和数值序列)。
+ *
+ * @return {stress_demo_t*} 返回 stress_demo 对象。
+ */
+stress_demo_t* stress_demo_create(widget_t* parent, uint32_t n, bool_t group, uint32_t seed);
+
+/**
+ * @method stress_demo_update
+ * 随机修改全部进度条的值(时间计入帧时间)。
+ * @param {stress_demo_t*} demo stress_demo 对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t stress_demo_update(stress_demo_t* demo);
+
+/**
+ * @method stress_demo_paint_begin
+ * 开始绘制一帧。
+ * @param {stress_demo_t*} demo stress_demo 对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t stress_demo_paint_begin(stress_demo_t* demo);
+
+/**
+ * @method stress_demo_paint_end
+ * 结束绘制一帧，记录这一帧的时间(上次以来的更新时间加上绘制时间)和内存。
+ * @param {stress_demo_t*} demo stress_demo 对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t stress_demo_paint_end(stress_demo_t* demo);
+
+/**
+ * @method stress_demo_report
+ * 生成统计报告。
+ * @param {stress_demo_t*} demo stress_demo 对象。
+ * @param {str_t*} str 返回报告。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t stress_demo_report(stress_demo_t* demo, str_t* str);
+
+/**
+ * @method stress_demo_destroy
+ * 销毁 stress_demo 对象(不销毁控件)。
+ * @param {stress_demo_t*} demo stress_demo 对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t stress_demo_destroy(stress_demo_t* demo);
+
+/**
+ * @method stress_demo_open
+ * 打开一个压力测试窗口，每一帧更新全部进度条，关闭窗口时输出统计报告。
+ * @param {uint32_t} n 进度条的个数(10-5000)。
+ * @param {bool_t} group 是否放到 progress\_polygon\_group 中合并绘制。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t stress_demo_open(uint32_t n, bool_t group);
+
+END_C_DECLS
+
+#endif /*TK_STRESS_DEMO_H*/
@@ -0,0 +1,171 @@
+﻿/**
+ * File:   stress_main.c
+ * Author: AWTK Develop Team
+ * Brief:  无界面运行压力测试，在离线画布上绘制。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#include <stdio.h>
+#include "awtk.h"
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "base/idle.h"
+#include "base/timer.h"
+#include "base/system_info.h"
+#include "lcd/lcd_mem_bgr565.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "progress_polygon_register.h"
+#include "progress_polygon/progress_polygon.h"
+#include "stress_demo.h"
+
+/*由 stress_assets.c 中包含的 res/assets.inc 提供*/
+extern ret_t assets_init(void);
+
+typedef struct _stress_options_t {
+  uint32_t n;
+  uint32_t frames;
+  wh_t w;
+  wh_t h;
+  bool_t group;
+  bool_t bgr565;
+  uint32_t seed;
+} stress_options_t;
+
+static void stress_usage(const char* name) {
+  printf("Usage: %s [-n gauges(10-5000)] [-f frames] [-s WxH] [-m bgra8888|bgr565] [-g 1|0] "
+         "[-r seed]\n",
+         name);
+}
+
+static ret_t stress_parse_options(stress_options_t* options, int argc, char* argv[]) {
+  int i = 0;
+
+  options->n = STRESS_DEMO_DEFAULT_NR;
+  options->frames = 300;
+  options->w = 800;
+  options->h = 480;
+  options->group = TRUE;
+  options->bgr565 = FALSE;
+  options->seed = 1;
+
+  for (i = 1; i + 1 < argc; i += 2) {
+    const char* value = argv[i + 1];
+
+    if (tk_str_eq(argv[i], "-n")) {
+      options->n = tk_atoi(value);
+    } else if (tk_str_eq(argv[i], "-f")) {
+      options->frames = tk_max(tk_atoi(value), 1);
+    } else if (tk_str_eq(argv[i], "-s")) {
+      const char* h = strchr(value, 'x');
+      options->w = tk_atoi(value);
+      options->h = h != NULL ? tk_atoi(h + 1) : 0;
+    } else if (tk_str_eq(argv[i], "-m")) {
+      options->bgr565 = tk_str_eq(value, "bgr565");
+    } else if (tk_str_eq(argv[i], "-g")) {
+      options->group = tk_atoi(value) != 0;
+    } else if (tk_str_eq(argv[i], "-r")) {
+      options->seed = tk_atoi(value);
+    } else {
+      return RET_BAD_PARAMS;
+    }
+  }
+
+  return i == argc && options->w > 0 && options->h > 0 ? RET_OK : RET_BAD_PARAMS;
+}
+
+static ret_t stress_run(const stress_options_t* options) {
+  str_t str;
+  canvas_t c;
+  uint32_t i = 0;
+  lcd_t* lcd = NULL;
+  widget_t* win = NULL;
+  stress_demo_t* demo = NULL;
+  rect_t r = rect_init(0, 0, options->w, options->h);
+  uint32_t bpp = options->bgr565 ? 2 : 4;
+  uint8_t* buff = TKMEM_ZALLOCN(uint8_t, options->w * options->h * bpp);
+  return_value_if_fail(buff != NULL, RET_OOM);
+
+  if (options->bgr565) {
+    lcd = lcd_mem_bgr565_create_single_fb(options->w, options->h, buff);
+  } else {
+    lcd = lcd_mem_bgra8888_create_single_fb(options->w, options->h, buff);
+  }
+  canvas_init(&c, lcd, font_manager());
+
+  win = window_create(NULL, 0, 0, options->w, options->h);
+  widget_set_prop_str(win, WIDGET_PROP_THEME, "main");
+  demo = stress_demo_create(win, options->n, options->group, options->seed);
+
+  for (i = 0; demo != NULL && i < options->frames; i++) {
+    /*第一帧绘制原始的值，之后每一帧先随机修改全部的值*/
+    if (i > 0) {
+      stress_demo_update(demo);
+    }
+
+    /*分发定时器和空闲任务(后台准备好的几何数据在这里替换到控件中)*/
+    timer_dispatch();
+    idle_dispatch();
+
+    stress_demo_paint_begin(demo);
+    canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+    widget_paint(win, &c);
+    canvas_end_frame(&c);
+    stress_demo_paint_end(demo);
+  }
+
+  if (demo != NULL) {
+    str_init(&str, 1024);
+    str_append_format(&str, 128, "canvas: %dx%d %s\n", options->w, options->h,
+                      options->bgr565 ? "bgr565" : "bgra8888");
+    stress_demo_report(demo, &str);
+    printf("%s", str.str);
+    str_reset(&str);
+    stress_demo_destroy(demo);
+  }
+
+  widget_destroy(win);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+  TKMEM_FREE(buff);
+
+  return demo != NULL ? RET_OK : RET_FAIL;
+}
+
+int main(int argc, char* argv[]) {
+  ret_t ret = RET_OK;
+  stress_options_t options;
+
+  if (stress_parse_options(&options, argc, argv) != RET_OK) {
+    stress_usage(argv[0]);
+    return 1;
+  }
+
+  platform_prepare();
+  system_info_init(APP_SIMULATOR, NULL, "./");
+  tk_init_internal();
+  assets_init();
+  tk_init_assets();
+  progress_polygon_register();
+
+  ret = stress_run(&options);
+
+  progress_polygon_unregister();
+  tk_deinit_internal();
+
+  return ret == RET_OK ? 0 : 1;
+}
@@ -1,5 +1,7 @@
 ﻿#include "awtk.h"
 #include "progress_polygon_register.h"
+#include "progress_polygon/progress_polygon.h"
+#include "stress/stress_demo.h"
 
 static ret_t on_close(void* ctx, event_t* e) {
   tk_quit();
@@ -7,6 +9,10 @@ static ret_t on_close(void* ctx, event_t* e) {
   return RET_OK;
 }
 
+static ret_t on_stress(void* ctx, event_t* e) {
+  return stress_demo_open(STRESS_DEMO_DEFAULT_NR, TRUE);
+}
+
 /**
  * 初始化
  */
@@ -15,6 +21,8 @@ ret_t application_init(void) {
 
   widget_t* win = window_open("main");
   widget_child_on(win, "close", EVT_CLICK, on_close, NULL); 
+  widget_child_on(win, "stress", EVT_CLICK, on_stress, NULL);
+  progress_polygon_prewarm_all(win);
 
   return RET_OK;
 }
@@ -24,5 +32,7 @@ ret_t application_init(void) {
  */
 ret_t application_exit(void) {
   log_debug("application_exit\n");
+  progress_polygon_unregister();
+
   return RET_OK;
 }
@@ -0,0 +1,205 @@
+﻿/**
+ * File:   polygon_batch.c
+ * Author: AWTK Develop Team
+ * Brief:  批量计算多个进度条的分界线。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "polygon_batch.h"
+
+ret_t polygon_batch_init(polygon_batch_t* batch) {
+  return_value_if_fail(batch != NULL, RET_BAD_PARAMS);
+
+  memset(batch, 0x00, sizeof(polygon_batch_t));
+
+  return RET_OK;
+}
+
+ret_t polygon_batch_reset(polygon_batch_t* batch, uint32_t capacity) {
+  uint32_t n = 0;
+  uint8_t* data = NULL;
+  return_value_if_fail(batch != NULL, RET_BAD_PARAMS);
+
+  batch->size = 0;
+  if (capacity <= batch->capacity) {
+    return RET_OK;
+  }
+
+  /*每个进度条: 4个 double，两条分界线各 11 个 float 和 1 个 uint32_t，1个指针*/
+  n = capacity * 2;
+  data = (uint8_t*)TKMEM_ALLOC(capacity * 4 * sizeof(double) + n * 11 * sizeof(float) +
+                               n * sizeof(uint32_t) + capacity * sizeof(polygon_geometry_t*));
+  return_value_if_fail(data != NULL, RET_OOM);
+
+  polygon_batch_deinit(batch);
+  batch->capacity = capacity;
+  batch->inputs = (double*)data;
+  batch->progress = (float*)(batch->inputs + capacity * 4);
+  batch->t = batch->progress + n;
+  batch->values = batch->t + n;
+  batch->points = batch->values + n;
+  batch->next = batch->points + n * 4;
+  batch->offsets = (uint32_t*)(batch->next + n * 4);
+  batch->geos = (const polygon_geometry_t**)(batch->offsets + n);
+
+  return RET_OK;
+}
+
+ret_t polygon_batch_add(polygon_batch_t* batch, const polygon_geometry_t* geo, double start_value,
+                        double value, double min, double max) {
+  uint32_t i = 0;
+  uint32_t capacity = 0;
+  return_value_if_fail(batch != NULL && batch->size < batch->capacity, RET_BAD_PARAMS);
+  return_value_if_fail(geo != NULL && geo->size > 0 && max > min, RET_BAD_PARAMS);
+
+  i = batch->size++;
+  capacity = batch->capacity;
+  batch->geos[i] = geo;
+  batch->inputs[i] = start_value;
+  batch->inputs[capacity + i] = value;
+  batch->inputs[capacity * 2 + i] = min;
+  batch->inputs[capacity * 3 + i] = max;
+
+  return RET_OK;
+}
+
+static void polygon_batch_gather(polygon_batch_t* batch, uint32_t k, const polygon_geometry_t* geo,
+                                 uint32_t next) {
+  uint32_t stride = batch->capacity * 2;
+  uint32_t prev = next > 0 ? next - 1 : next;
+  float progress = batch->progress[k];
+
+  batch->offsets[k] = next;
+  if (prev != next && geo->values[next] > geo->values[prev] && geo->values[next] >= progress) {
+    batch->t[k] = (progress - geo->values[prev]) / (geo->values[next] - geo->values[prev]);
+    batch->values[k] = progress;
+  } else {
+    /*不需要插值时前后两点相同*/
+    prev = next;
+    batch->t[k] = 0;
+    batch->values[k] = geo->values[next];
+  }
+
+  batch->points[k] = geo->x1[prev];
+  batch->points[stride + k] = geo->y1[prev];
+  batch->points[stride * 2 + k] = geo->x2[prev];
+  batch->points[stride * 3 + k] = geo->y2[prev];
+  batch->next[k] = geo->x1[next];
+  batch->next[stride + k] = geo->y1[next];
+  batch->next[stride * 2 + k] = geo->x2[next];
+  batch->next[stride * 3 + k] = geo->y2[next];
+}
+
+ret_t polygon_batch_compute(polygon_batch_t* batch) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t n = 0;
+  uint32_t stride = 0;
+  const double* start = NULL;
+  const double* value = NULL;
+  const double* min = NULL;
+  const double* max = NULL;
+  float* from = NULL;
+  float* to = NULL;
+  const float* t = NULL;
+  return_value_if_fail(batch != NULL, RET_BAD_PARAMS);
+
+  n = batch->size;
+  stride = batch->capacity * 2;
+  start = batch->inputs;
+  value = start + batch->capacity;
+  min = value + batch->capacity;
+  max = min + batch->capacity;
+  from = batch->progress;
+  to = from + n;
+
+  /*换算为进度，起始进度不大于结束进度，没有函数调用和数据相关的跳转，便于编译器向量化*/
+  for (i = 0; i < n; i++) {
+    double lo = min[i];
+    double hi = max[i];
+    double a = start[i];
+    double b = value[i];
+
+    a = a < lo ? lo : a;
+    a = a > hi ? hi : a;
+    b = b < lo ? lo : b;
+    b = b > hi ? hi : b;
+    a = (a - lo) / (hi - lo);
+    b = (b - lo) / (hi - lo);
+
+    from[i] = tk_min(a, b);
+    to[i] = tk_max(a, b);
+  }
+
+  /*二分查找只能逐个进行，查找结束分界线时从起始分界线的位置开始*/
+  for (i = 0; i < n; i++) {
+    const polygon_geometry_t* geo = batch->geos[i];
+    uint32_t from_offset = polygon_geometry_find(geo, from[i]);
+
+    polygon_batch_gather(batch, i, geo, from_offset);
+    polygon_batch_gather(batch, n + i, geo, polygon_geometry_find_from(geo, from_offset, to[i]));
+  }
+
+  /*四列坐标，每列 2 * n 条分界线一起插值*/
+  t = batch->t;
+  for (j = 0; j < 4; j++) {
+    float* a = batch->points + stride * j;
+    const float* b = batch->next + stride * j;
+
+    for (i = 0; i < n * 2; i++) {
+      a[i] += (b[i] - a[i]) * t[i];
+    }
+  }
+
+  return RET_OK;
+}
+
+static void polygon_batch_get_point(const polygon_batch_t* batch, uint32_t k, polygon_point_t* p) {
+  uint32_t stride = batch->capacity * 2;
+
+  p->value = batch->values[k];
+  p->x1 = batch->points[k];
+  p->y1 = batch->points[stride + k];
+  p->x2 = batch->points[stride * 2 + k];
+  p->y2 = batch->points[stride * 3 + k];
+}
+
+ret_t polygon_batch_get_range(const polygon_batch_t* batch, uint32_t index, uint32_t* from_offset,
+                              polygon_point_t* from, uint32_t* to_offset, polygon_point_t* to) {
+  return_value_if_fail(batch != NULL && index < batch->size, RET_BAD_PARAMS);
+  return_value_if_fail(from_offset != NULL && from != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(to_offset != NULL && to != NULL, RET_BAD_PARAMS);
+
+  *from_offset = batch->offsets[index];
+  polygon_batch_get_point(batch, index, from);
+  *to_offset = batch->offsets[batch->size + index];
+  polygon_batch_get_point(batch, batch->size + index, to);
+
+  return RET_OK;
+}
+
+ret_t polygon_batch_deinit(polygon_batch_t* batch) {
+  return_value_if_fail(batch != NULL, RET_BAD_PARAMS);
+
+  TKMEM_FREE(batch->inputs);
+  memset(batch, 0x00, sizeof(polygon_batch_t));
+
+  return RET_OK;
+}
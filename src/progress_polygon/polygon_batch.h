@@ -0,0 +1,134 @@
+﻿/**
+ * File:   polygon_batch.h
+ * Author: AWTK Develop Team
+ * Brief:  批量计算多个进度条的分界线。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#ifndef TK_POLYGON_BATCH_H
+#define TK_POLYGON_BATCH_H
+
+#include "polygon_geometry.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class polygon_batch_t
+ * 批量计算多个进度条的分界线。
+ *
+ * 每个进度条的 start\_value/value/min/max 按列连续存放，换算进度和插值分界线都是
+ * 在连续数组上的简单循环，便于编译器向量化，只有二分查找需要逐个进行。
+ * 每个进度条有两条分界线(起始和结束)，结果按列(value/x1/y1/x2/y2)连续存放。
+ */
+typedef struct _polygon_batch_t {
+  /**
+   * @property {uint32_t} size
+   * 进度条的个数。
+   */
+  uint32_t size;
+  /**
+   * @property {uint32_t} capacity
+   * 最多可以存放的进度条的个数。
+   */
+  uint32_t capacity;
+
+  /*以下数组在同一块内存中，inputs 为起始地址*/
+  /*start_value/value/min/max 各 capacity 个*/
+  double* inputs;
+  /*分界线: 前 size 个为起始，后 size 个为结束，每列 capacity * 2 个*/
+  float* progress;
+  float* t;
+  float* values;
+  /*x1/y1/x2/y2 四列，插值前为前一个点，插值后为分界线*/
+  float* points;
+  /*x1/y1/x2/y2 四列，后一个点*/
+  float* next;
+  uint32_t* offsets;
+  const polygon_geometry_t** geos;
+} polygon_batch_t;
+
+/**
+ * @method polygon_batch_init
+ * 初始化。
+ * @param {polygon_batch_t*} batch batch对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_batch_init(polygon_batch_t* batch);
+
+/**
+ * @method polygon_batch_reset
+ * 清空，并确保可以存放 capacity 个进度条(容量足够时不会重新分配内存)。
+ * @param {polygon_batch_t*} batch batch对象。
+ * @param {uint32_t} capacity 进度条的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_batch_reset(polygon_batch_t* batch, uint32_t capacity);
+
+/**
+ * @method polygon_batch_add
+ * 添加一个进度条。
+ * @param {polygon_batch_t*} batch batch对象。
+ * @param {const polygon_geometry_t*} geo 几何数据(计算完成之前必须保持有效)。
+ * @param {double} start_value 起始值。
+ * @param {double} value 值。
+ * @param {double} min 最小值。
+ * @param {double} max 最大值(必须大于 min)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_batch_add(polygon_batch_t* batch, const polygon_geometry_t* geo, double start_value,
+                        double value, double min, double max);
+
+/**
+ * @method polygon_batch_compute
+ * 计算全部进度条的分界线。
+ * @param {polygon_batch_t*} batch batch对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_batch_compute(polygon_batch_t* batch);
+
+/**
+ * @method polygon_batch_get_range
+ * 获取第 index 个进度条的两条分界线(结果与 polygon\_geometry\_get\_range 相同)。
+ * @param {const polygon_batch_t*} batch batch对象。
+ * @param {uint32_t} index 序号。
+ * @param {uint32_t*} from_offset 返回起始分界线对应的 polygon\_geometry\_find 的结果。
+ * @param {polygon_point_t*} from 返回起始分界线。
+ * @param {uint32_t*} to_offset 返回结束分界线对应的 polygon\_geometry\_find 的结果。
+ * @param {polygon_point_t*} to 返回结束分界线。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_batch_get_range(const polygon_batch_t* batch, uint32_t index, uint32_t* from_offset,
+                              polygon_point_t* from, uint32_t* to_offset, polygon_point_t* to);
+
+/**
+ * @method polygon_batch_deinit
+ * 释放 batch 对象。
+ * @param {polygon_batch_t*} batch batch对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_batch_deinit(polygon_batch_t* batch);
+
+END_C_DECLS
+
+#endif /*TK_POLYGON_BATCH_H*/
@@ -0,0 +1,265 @@
+﻿/**
+ * File:   polygon_geometry.c
+ * Author: AWTK Develop Team
+ * Brief:  多边形几何数据(已换算为像素坐标)。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#include "tkc/utils.h"
+#include "polygon_pool.h"
+#include "polygon_geometry.h"
+
+ret_t polygon_geometry_init(polygon_geometry_t* geo) {
+  return_value_if_fail(geo != NULL, RET_BAD_PARAMS);
+
+  memset(geo, 0x00, sizeof(polygon_geometry_t));
+
+  return RET_OK;
+}
+
+ret_t polygon_geometry_ensure_size(polygon_geometry_t* geo, uint32_t size) {
+  float* data = NULL;
+  return_value_if_fail(geo != NULL && size > 0, RET_BAD_PARAMS);
+
+  if (geo->values != NULL && geo->size == size) {
+    return RET_OK;
+  }
+
+  data = (float*)polygon_pool_alloc(size * 5 * sizeof(float));
+  return_value_if_fail(data != NULL, RET_OOM);
+
+  if (geo->values != NULL) {
+    polygon_pool_free(geo->values, geo->size * 5 * sizeof(float));
+  }
+
+  geo->size = size;
+  geo->values = data;
+  geo->x1 = data + size;
+  geo->y1 = data + size * 2;
+  geo->x2 = data + size * 3;
+  geo->y2 = data + size * 4;
+
+  return RET_OK;
+}
+
+static void polygon_geometry_normalize(float* dst, const float* src, uint32_t n, wh_t size) {
+  uint32_t i = 0;
+
+  /*大于1的是像素坐标，否则是相对坐标*/
+  for (i = 0; i < n; i++) {
+    dst[i] = src[i] > 1 ? src[i] : src[i] * size;
+  }
+}
+
+ret_t polygon_geometry_resolve(polygon_geometry_t* geo, const polygon_stations_t* stations,
+                               wh_t w, wh_t h) {
+  uint32_t n = 0;
+  return_value_if_fail(geo != NULL && stations != NULL && stations->size > 0, RET_BAD_PARAMS);
+  return_value_if_fail(polygon_geometry_ensure_size(geo, stations->size) == RET_OK, RET_OOM);
+
+  n = stations->size;
+  memcpy(geo->values, POLYGON_STATIONS_VALUES(stations), n * sizeof(float));
+  polygon_geometry_normalize(geo->x1, POLYGON_STATIONS_X1(stations), n, w);
+  polygon_geometry_normalize(geo->y1, POLYGON_STATIONS_Y1(stations), n, h);
+  polygon_geometry_normalize(geo->x2, POLYGON_STATIONS_X2(stations), n, w);
+  polygon_geometry_normalize(geo->y2, POLYGON_STATIONS_Y2(stations), n, h);
+
+  geo->w = w;
+  geo->h = h;
+
+  return RET_OK;
+}
+
+static float polygon_geometry_normalize_one(float v, wh_t size) {
+  return v > 1 ? v : v * size;
+}
+
+ret_t polygon_geometry_resolve_coarse(polygon_geometry_t* geo, const polygon_stations_t* stations,
+                                      wh_t w, wh_t h, uint32_t max_size) {
+  uint32_t i = 0;
+  uint32_t k = 0;
+  uint32_t n = 0;
+  uint32_t m = 0;
+  return_value_if_fail(geo != NULL && stations != NULL && stations->size > 0, RET_BAD_PARAMS);
+  return_value_if_fail(max_size >= 2, RET_BAD_PARAMS);
+
+  n = stations->size;
+  if (n <= max_size) {
+    return polygon_geometry_resolve(geo, stations, w, h);
+  }
+
+  m = max_size;
+  return_value_if_fail(polygon_geometry_ensure_size(geo, m) == RET_OK, RET_OOM);
+  for (k = 0; k < m; k++) {
+    i = (uint32_t)((uint64_t)k * (n - 1) / (m - 1));
+    geo->values[k] = POLYGON_STATIONS_VALUES(stations)[i];
+    geo->x1[k] = polygon_geometry_normalize_one(POLYGON_STATIONS_X1(stations)[i], w);
+    geo->y1[k] = polygon_geometry_normalize_one(POLYGON_STATIONS_Y1(stations)[i], h);
+    geo->x2[k] = polygon_geometry_normalize_one(POLYGON_STATIONS_X2(stations)[i], w);
+    geo->y2[k] = polygon_geometry_normalize_one(POLYGON_STATIONS_Y2(stations)[i], h);
+  }
+
+  geo->w = w;
+  geo->h = h;
+
+  return RET_OK;
+}
+
+bool_t polygon_geometry_is_valid_for(const polygon_geometry_t* geo, wh_t w, wh_t h) {
+  return_value_if_fail(geo != NULL, FALSE);
+
+  return geo->size > 0 && geo->w == w && geo->h == h;
+}
+
+uint32_t polygon_geometry_get_mem_size(const polygon_geometry_t* geo) {
+  return_value_if_fail(geo != NULL, 0);
+
+  return geo->size > 0 ? polygon_pool_block_size(geo->size * 5 * sizeof(float)) : 0;
+}
+
+static uint32_t polygon_geometry_lower_bound(const polygon_geometry_t* geo, uint32_t low,
+                                             float progress) {
+  uint32_t high = geo->size;
+
+  while (low < high) {
+    uint32_t mid = low + (high - low) / 2;
+    if (geo->values[mid] >= progress) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+
+  return low < geo->size ? low : geo->size - 1;
+}
+
+uint32_t polygon_geometry_find(const polygon_geometry_t* geo, float progress) {
+  return_value_if_fail(geo != NULL && geo->size > 0, 0);
+
+  return polygon_geometry_lower_bound(geo, 0, progress);
+}
+
+uint32_t polygon_geometry_find_from(const polygon_geometry_t* geo, uint32_t low, float progress) {
+  return_value_if_fail(geo != NULL && geo->size > 0, 0);
+
+  return polygon_geometry_lower_bound(geo, tk_min(low, geo->size - 1), progress);
+}
+
+static void polygon_geometry_interpolate(const polygon_geometry_t* geo, uint32_t next,
+                                         float progress, polygon_point_t* boundary) {
+  uint32_t prev = next > 0 ? next - 1 : next;
+  float interpolate = 0;
+
+  if (prev != next && geo->values[next] > geo->values[prev] && geo->values[next] >= progress) {
+    interpolate = (progress - geo->values[prev]) / (geo->values[next] - geo->values[prev]);
+    boundary->value = progress;
+    boundary->x1 = geo->x1[prev] + (geo->x1[next] - geo->x1[prev]) * interpolate;
+    boundary->y1 = geo->y1[prev] + (geo->y1[next] - geo->y1[prev]) * interpolate;
+    boundary->x2 = geo->x2[prev] + (geo->x2[next] - geo->x2[prev]) * interpolate;
+    boundary->y2 = geo->y2[prev] + (geo->y2[next] - geo->y2[prev]) * interpolate;
+  } else {
+    boundary->value = geo->values[next];
+    boundary->x1 = geo->x1[next];
+    boundary->y1 = geo->y1[next];
+    boundary->x2 = geo->x2[next];
+    boundary->y2 = geo->y2[next];
+  }
+}
+
+ret_t polygon_geometry_get_boundary(const polygon_geometry_t* geo, float progress,
+                                    uint32_t* offset, polygon_point_t* boundary) {
+  return_value_if_fail(geo != NULL && geo->size > 0, RET_BAD_PARAMS);
+  return_value_if_fail(offset != NULL && boundary != NULL, RET_BAD_PARAMS);
+
+  *offset = polygon_geometry_lower_bound(geo, 0, progress);
+  polygon_geometry_interpolate(geo, *offset, progress, boundary);
+
+  return RET_OK;
+}
+
+ret_t polygon_geometry_get_range(const polygon_geometry_t* geo, float from, float to,
+                                 uint32_t* from_offset, polygon_point_t* from_boundary,
+                                 uint32_t* to_offset, polygon_point_t* to_boundary) {
+  return_value_if_fail(geo != NULL && geo->size > 0 && from <= to, RET_BAD_PARAMS);
+  return_value_if_fail(from_offset != NULL && from_boundary != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(to_offset != NULL && to_boundary != NULL, RET_BAD_PARAMS);
+
+  *from_offset = polygon_geometry_lower_bound(geo, 0, from);
+  polygon_geometry_interpolate(geo, *from_offset, from, from_boundary);
+
+  /*to 不小于 from，只需要在后面查找*/
+  *to_offset = polygon_geometry_lower_bound(geo, *from_offset, to);
+  polygon_geometry_interpolate(geo, *to_offset, to, to_boundary);
+
+  return RET_OK;
+}
+
+static void polygon_geometry_extend(float* bounds, float x, float y) {
+  bounds[0] = tk_min(bounds[0], x);
+  bounds[1] = tk_min(bounds[1], y);
+  bounds[2] = tk_max(bounds[2], x);
+  bounds[3] = tk_max(bounds[3], y);
+}
+
+ret_t polygon_geometry_get_band(const polygon_geometry_t* geo, float from, float to, rect_t* r) {
+  uint32_t i = 0;
+  uint32_t start = 0;
+  uint32_t end = 0;
+  float bounds[4];
+  polygon_point_t a;
+  polygon_point_t b;
+  return_value_if_fail(geo != NULL && geo->size > 0 && r != NULL, RET_BAD_PARAMS);
+
+  if (from > to) {
+    float t = from;
+    from = to;
+    to = t;
+  }
+
+  polygon_geometry_get_range(geo, from, to, &start, &a, &end, &b);
+
+  bounds[0] = bounds[2] = a.x1;
+  bounds[1] = bounds[3] = a.y1;
+  polygon_geometry_extend(bounds, a.x2, a.y2);
+  polygon_geometry_extend(bounds, b.x1, b.y1);
+  polygon_geometry_extend(bounds, b.x2, b.y2);
+
+  /*两个边界之间的点*/
+  for (i = start; i < end; i++) {
+    polygon_geometry_extend(bounds, geo->x1[i], geo->y1[i]);
+    polygon_geometry_extend(bounds, geo->x2[i], geo->y2[i]);
+  }
+
+  r->x = (xy_t)floorf(bounds[0]) - 1;
+  r->y = (xy_t)floorf(bounds[1]) - 1;
+  r->w = (wh_t)ceilf(bounds[2]) - r->x + 1;
+  r->h = (wh_t)ceilf(bounds[3]) - r->y + 1;
+
+  return RET_OK;
+}
+
+ret_t polygon_geometry_deinit(polygon_geometry_t* geo) {
+  return_value_if_fail(geo != NULL, RET_BAD_PARAMS);
+
+  if (geo->values != NULL) {
+    polygon_pool_free(geo->values, geo->size * 5 * sizeof(float));
+  }
+  memset(geo, 0x00, sizeof(polygon_geometry_t));
+
+  return RET_OK;
+}
@@ -0,0 +1,205 @@
+﻿/**
+ * File:   polygon_geometry.h
+ * Author: AWTK Develop Team
+ * Brief:  多边形几何数据(已换算为像素坐标)。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#ifndef TK_POLYGON_GEOMETRY_H
+#define TK_POLYGON_GEOMETRY_H
+
+#include "tkc/rect.h"
+#include "polygon_points.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class polygon_geometry_t
+ * 多边形几何数据。
+ *
+ * 由 polygon_stations_t 按控件大小换算为像素坐标后得到，按列(value/x1/y1/x2/y2)连续存放，
+ * 只有控件大小或多边形描述变化时才需要重新计算。
+ */
+typedef struct _polygon_geometry_t {
+  /**
+   * @property {wh_t} w
+   * 计算时控件的宽度。
+   */
+  wh_t w;
+  /**
+   * @property {wh_t} h
+   * 计算时控件的高度。
+   */
+  wh_t h;
+  /**
+   * @property {uint32_t} size
+   * 点的个数。
+   */
+  uint32_t size;
+
+  /*一整块内存，values 为起始地址*/
+  float* values;
+  float* x1;
+  float* y1;
+  float* x2;
+  float* y2;
+} polygon_geometry_t;
+
+/**
+ * @method polygon_geometry_init
+ * 初始化。
+ * @param {polygon_geometry_t*} geo 几何数据。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_geometry_init(polygon_geometry_t* geo);
+
+/**
+ * @method polygon_geometry_ensure_size
+ * 确保可以存放 size 个点(个数不变时不会重新分配内存)。
+ * @param {polygon_geometry_t*} geo 几何数据。
+ * @param {uint32_t} size 点的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_geometry_ensure_size(polygon_geometry_t* geo, uint32_t size);
+
+/**
+ * @method polygon_geometry_resolve
+ * 根据多边形描述和控件大小计算像素坐标。
+ * @param {polygon_geometry_t*} geo 几何数据。
+ * @param {const polygon_stations_t*} stations 多边形描述。
+ * @param {wh_t} w 控件的宽度。
+ * @param {wh_t} h 控件的高度。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_geometry_resolve(polygon_geometry_t* geo, const polygon_stations_t* stations,
+                               wh_t w, wh_t h);
+
+/**
+ * @method polygon_geometry_resolve_coarse
+ * 只取均匀间隔的最多 max_size 个点计算像素坐标(第一个和最后一个点总会保留)。
+ * 精确的几何数据还没有准备好时，用它来绘制一个简化的形状。
+ * @param {polygon_geometry_t*} geo 几何数据。
+ * @param {const polygon_stations_t*} stations 多边形描述。
+ * @param {wh_t} w 控件的宽度。
+ * @param {wh_t} h 控件的高度。
+ * @param {uint32_t} max_size 最多保留的点数(不小于2)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_geometry_resolve_coarse(polygon_geometry_t* geo, const polygon_stations_t* stations,
+                                      wh_t w, wh_t h, uint32_t max_size);
+
+/**
+ * @method polygon_geometry_is_valid_for
+ * 检查几何数据是否与指定的控件大小匹配。
+ * @param {const polygon_geometry_t*} geo 几何数据。
+ * @param {wh_t} w 控件的宽度。
+ * @param {wh_t} h 控件的高度。
+ *
+ * @return {bool_t} 返回TRUE表示可以直接使用，否则需要重新计算。
+ */
+bool_t polygon_geometry_is_valid_for(const polygon_geometry_t* geo, wh_t w, wh_t h);
+
+/**
+ * @method polygon_geometry_get_mem_size
+ * 获取占用的内存(字节)。
+ * @param {const polygon_geometry_t*} geo 几何数据。
+ *
+ * @return {uint32_t} 返回占用的内存。
+ */
+uint32_t polygon_geometry_get_mem_size(const polygon_geometry_t* geo);
+
+/**
+ * @method polygon_geometry_find
+ * 查找第一个 value 不小于 progress 的点(点按 value 递增排列，使用二分查找)。
+ * @param {const polygon_geometry_t*} geo 几何数据。
+ * @param {float} progress 进度(0-1)。
+ *
+ * @return {uint32_t} 返回点的索引(不会超过 size - 1)。
+ */
+uint32_t polygon_geometry_find(const polygon_geometry_t* geo, float progress);
+
+/**
+ * @method polygon_geometry_find_from
+ * 与 polygon\_geometry\_find 相同，但只在 low 及之后的点中查找(已知前面的点都小于 progress)。
+ * @param {const polygon_geometry_t*} geo 几何数据。
+ * @param {uint32_t} low 开始查找的位置。
+ * @param {float} progress 进度(0-1)。
+ *
+ * @return {uint32_t} 返回点的索引(不会超过 size - 1)。
+ */
+uint32_t polygon_geometry_find_from(const polygon_geometry_t* geo, uint32_t low, float progress);
+
+/**
+ * @method polygon_geometry_get_boundary
+ * 计算进度为 progress 时的分界线。
+ * @param {const polygon_geometry_t*} geo 几何数据。
+ * @param {float} progress 进度(0-1)。
+ * @param {uint32_t*} offset 返回 polygon_geometry_find 的结果。
+ * @param {polygon_point_t*} boundary 返回分界线(像素坐标)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_geometry_get_boundary(const polygon_geometry_t* geo, float progress,
+                                    uint32_t* offset, polygon_point_t* boundary);
+
+/**
+ * @method polygon_geometry_get_range
+ * 同时计算进度为 from 和 to(from 不大于 to)时的两条分界线，查找 to 时从 from 的位置开始。
+ * @param {const polygon_geometry_t*} geo 几何数据。
+ * @param {float} from 起始进度(0-1)。
+ * @param {float} to 结束进度(0-1)。
+ * @param {uint32_t*} from_offset 返回 from 对应的 polygon_geometry_find 的结果。
+ * @param {polygon_point_t*} from_boundary 返回 from 对应的分界线。
+ * @param {uint32_t*} to_offset 返回 to 对应的 polygon_geometry_find 的结果。
+ * @param {polygon_point_t*} to_boundary 返回 to 对应的分界线。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_geometry_get_range(const polygon_geometry_t* geo, float from, float to,
+                                 uint32_t* from_offset, polygon_point_t* from_boundary,
+                                 uint32_t* to_offset, polygon_point_t* to_boundary);
+
+/**
+ * @method polygon_geometry_get_band
+ * 获取进度在 from 和 to 之间的部分的包围矩形(向外扩展 1 像素，包含抗锯齿的像素)。
+ * 进度变化时只需要刷新这个区域。
+ * @param {const polygon_geometry_t*} geo 几何数据。
+ * @param {float} from 进度(0-1)。
+ * @param {float} to 进度(0-1)。
+ * @param {rect_t*} r 返回包围矩形。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_geometry_get_band(const polygon_geometry_t* geo, float from, float to, rect_t* r);
+
+/**
+ * @method polygon_geometry_deinit
+ * 释放几何数据。
+ * @param {polygon_geometry_t*} geo 几何数据。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_geometry_deinit(polygon_geometry_t* geo);
+
+END_C_DECLS
+
+#endif /*TK_POLYGON_GEOMETRY_H*/
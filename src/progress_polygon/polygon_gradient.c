@@ -0,0 +1,298 @@
+﻿/**
+ * File:   polygon_gradient.c
+ * Author: AWTK Develop Team
+ * Brief:  沿进度方向的渐变色。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#include "tkc/utils.h"
+#include "base/color_parser.h"
+#include "polygon_pool.h"
+#include "polygon_gradient.h"
+
+#define POLYGON_GRADIENT_STOP_LEN 63
+
+static ret_t polygon_gradient_parse_stop(polygon_gradient_t* gradient, const char* start,
+                                         uint32_t len) {
+  char stop[POLYGON_GRADIENT_STOP_LEN + 1];
+  const char* color = NULL;
+  const char* sep = NULL;
+  float pos = -1;
+
+  len = tk_min(len, POLYGON_GRADIENT_STOP_LEN);
+  memcpy(stop, start, len);
+  stop[len] = '\0';
+
+  color = tk_skip_chars(stop, " \t\r\n");
+  if (*color == '\0') {
+    return RET_SKIP;
+  }
+  return_value_if_fail(gradient->nr < POLYGON_GRADIENT_MAX_STOPS, RET_FAIL);
+
+  /*rgba(...) 中不会出现冒号*/
+  sep = strchr(color, ':');
+  if (sep != NULL) {
+    pos = tk_atof(color);
+    color = tk_skip_chars(sep + 1, " \t\r\n");
+  }
+
+  gradient->stops[gradient->nr] = pos;
+  gradient->colors[gradient->nr] = color_parse(color);
+  gradient->nr++;
+
+  return RET_OK;
+}
+
+ret_t polygon_gradient_init(polygon_gradient_t* gradient, const char* str) {
+  uint32_t i = 0;
+  const char* p = str;
+  const char* end = NULL;
+  return_value_if_fail(gradient != NULL && str != NULL, RET_BAD_PARAMS);
+
+  memset(gradient, 0x00, sizeof(polygon_gradient_t));
+  while (*p) {
+    end = tk_skip_to_chars(p, ";");
+    polygon_gradient_parse_stop(gradient, p, end - p);
+    p = *end ? end + 1 : end;
+  }
+  return_value_if_fail(gradient->nr > 0, RET_FAIL);
+
+  /*省略的位置均匀分布，并保证位置递增*/
+  for (i = 0; i < gradient->nr; i++) {
+    float pos = gradient->stops[i];
+
+    if (pos < 0) {
+      pos = gradient->nr > 1 ? (float)i / (gradient->nr - 1) : 0;
+    }
+    if (i > 0) {
+      pos = tk_max(pos, gradient->stops[i - 1]);
+    }
+    gradient->stops[i] = tk_min(pos, 1);
+  }
+
+  return RET_OK;
+}
+
+color_t polygon_gradient_get_color(const polygon_gradient_t* gradient, float progress) {
+  uint32_t i = 0;
+  float t = 0;
+  color_t c0, c1;
+  color_t c = color_init(0, 0, 0, 0);
+  return_value_if_fail(gradient != NULL && gradient->nr > 0, c);
+
+  if (progress <= gradient->stops[0]) {
+    return gradient->colors[0];
+  }
+
+  for (i = 1; i < gradient->nr; i++) {
+    if (progress < gradient->stops[i]) {
+      break;
+    }
+  }
+  if (i >= gradient->nr) {
+    return gradient->colors[gradient->nr - 1];
+  }
+
+  c0 = gradient->colors[i - 1];
+  c1 = gradient->colors[i];
+  t = (progress - gradient->stops[i - 1]) / (gradient->stops[i] - gradient->stops[i - 1]);
+
+  c.rgba.r = (uint8_t)(c0.rgba.r + (c1.rgba.r - c0.rgba.r) * t + 0.5f);
+  c.rgba.g = (uint8_t)(c0.rgba.g + (c1.rgba.g - c0.rgba.g) * t + 0.5f);
+  c.rgba.b = (uint8_t)(c0.rgba.b + (c1.rgba.b - c0.rgba.b) * t + 0.5f);
+  c.rgba.a = (uint8_t)(c0.rgba.a + (c1.rgba.a - c0.rgba.a) * t + 0.5f);
+
+  return c;
+}
+
+static uint32_t polygon_gradient_count_strips(const polygon_gradient_t* gradient,
+                                              const polygon_geometry_t* geo) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t n = geo->size;
+
+  for (i = 1; i < geo->size; i++) {
+    for (j = 0; j < gradient->nr; j++) {
+      if (gradient->stops[j] > geo->values[i - 1] && gradient->stops[j] < geo->values[i]) {
+        n++;
+      }
+    }
+  }
+
+  return n;
+}
+
+static void polygon_gradient_copy_point(polygon_geometry_t* dst, uint32_t k,
+                                        const polygon_geometry_t* src, uint32_t i) {
+  dst->values[k] = src->values[i];
+  dst->x1[k] = src->x1[i];
+  dst->y1[k] = src->y1[i];
+  dst->x2[k] = src->x2[i];
+  dst->y2[k] = src->y2[i];
+}
+
+static void polygon_gradient_lerp_point(polygon_geometry_t* dst, uint32_t k,
+                                        const polygon_geometry_t* src, uint32_t i, float value) {
+  float t = (value - src->values[i - 1]) / (src->values[i] - src->values[i - 1]);
+
+  dst->values[k] = value;
+  dst->x1[k] = src->x1[i - 1] + (src->x1[i] - src->x1[i - 1]) * t;
+  dst->y1[k] = src->y1[i - 1] + (src->y1[i] - src->y1[i - 1]) * t;
+  dst->x2[k] = src->x2[i - 1] + (src->x2[i] - src->x2[i - 1]) * t;
+  dst->y2[k] = src->y2[i - 1] + (src->y2[i] - src->y2[i - 1]) * t;
+}
+
+static ret_t polygon_gradient_fill_strips(polygon_gradient_t* gradient,
+                                          const polygon_geometry_t* geo) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t k = 0;
+  polygon_geometry_t* strips = &(gradient->strips);
+
+  /*在相邻两点之间插入落在其中的关键点，关键点的颜色变化才不会被条带抹平*/
+  for (i = 0; i < geo->size; i++) {
+    if (i > 0) {
+      for (j = 0; j < gradient->nr; j++) {
+        float stop = gradient->stops[j];
+        if (stop > geo->values[i - 1] && stop < geo->values[i]) {
+          polygon_gradient_lerp_point(strips, k++, geo, i, stop);
+        }
+      }
+    }
+    polygon_gradient_copy_point(strips, k++, geo, i);
+  }
+
+  for (k = 0; k < strips->size; k++) {
+    gradient->strip_colors[k] = polygon_gradient_get_color(gradient, strips->values[k]);
+  }
+
+  strips->w = geo->w;
+  strips->h = geo->h;
+
+  return RET_OK;
+}
+
+ret_t polygon_gradient_build_strips(polygon_gradient_t* gradient, const polygon_geometry_t* geo) {
+  uint32_t n = 0;
+  polygon_geometry_t* strips = NULL;
+  return_value_if_fail(gradient != NULL && gradient->nr > 0, RET_BAD_PARAMS);
+  return_value_if_fail(geo != NULL && geo->size > 0, RET_BAD_PARAMS);
+
+  polygon_gradient_reset_strips(gradient);
+
+  strips = &(gradient->strips);
+  n = polygon_gradient_count_strips(gradient, geo);
+  return_value_if_fail(polygon_geometry_ensure_size(strips, n) == RET_OK, RET_OOM);
+  gradient->strip_colors = (color_t*)polygon_pool_alloc(n * sizeof(color_t));
+  if (gradient->strip_colors == NULL) {
+    polygon_geometry_deinit(strips);
+    return RET_OOM;
+  }
+
+  return polygon_gradient_fill_strips(gradient, geo);
+}
+
+ret_t polygon_gradient_update_strips(polygon_gradient_t* gradient, const polygon_geometry_t* geo) {
+  return_value_if_fail(gradient != NULL && gradient->nr > 0, RET_BAD_PARAMS);
+  return_value_if_fail(geo != NULL && geo->size > 0, RET_BAD_PARAMS);
+
+  if (!polygon_gradient_has_strips(gradient) ||
+      polygon_gradient_count_strips(gradient, geo) != gradient->strips.size) {
+    return polygon_gradient_build_strips(gradient, geo);
+  }
+
+  return polygon_gradient_fill_strips(gradient, geo);
+}
+
+static float polygon_gradient_next_stop(const polygon_gradient_t* gradient, float value) {
+  uint32_t i = 0;
+
+  for (i = 0; i < gradient->nr; i++) {
+    if (gradient->stops[i] > value) {
+      return gradient->stops[i];
+    }
+  }
+
+  return 2;
+}
+
+uint32_t polygon_gradient_get_run_end(const polygon_gradient_t* gradient, uint32_t start) {
+  uint32_t i = 0;
+  float dx = 0;
+  float dy = 0;
+  float stop = 0;
+  const polygon_geometry_t* strips = NULL;
+  return_value_if_fail(gradient != NULL && gradient->strips.size > 0, 0);
+
+  strips = &(gradient->strips);
+  if (start + 1 >= strips->size) {
+    return strips->size - 1;
+  }
+
+  /*中心线的方向，坐标都乘了 2，不影响角度*/
+  stop = polygon_gradient_next_stop(gradient, strips->values[start]);
+  dx = (strips->x1[start + 1] + strips->x2[start + 1]) - (strips->x1[start] + strips->x2[start]);
+  dy = (strips->y1[start + 1] + strips->y2[start + 1]) - (strips->y1[start] + strips->y2[start]);
+
+  for (i = start + 1; i + 1 < strips->size; i++) {
+    float vx = 0;
+    float vy = 0;
+    float dot = 0;
+
+    if (strips->values[i] >= stop) {
+      break;
+    }
+
+    /*和起点方向的夹角超过 60 度：cos < 0.5*/
+    vx = (strips->x1[i + 1] + strips->x2[i + 1]) - (strips->x1[start] + strips->x2[start]);
+    vy = (strips->y1[i + 1] + strips->y2[i + 1]) - (strips->y1[start] + strips->y2[start]);
+    dot = vx * dx + vy * dy;
+    if (dot < 0 || 4 * dot * dot < (vx * vx + vy * vy) * (dx * dx + dy * dy)) {
+      break;
+    }
+  }
+
+  return i;
+}
+
+bool_t polygon_gradient_has_strips(const polygon_gradient_t* gradient) {
+  return_value_if_fail(gradient != NULL, FALSE);
+
+  return gradient->strip_colors != NULL;
+}
+
+ret_t polygon_gradient_reset_strips(polygon_gradient_t* gradient) {
+  return_value_if_fail(gradient != NULL, RET_BAD_PARAMS);
+
+  if (gradient->strip_colors != NULL) {
+    polygon_pool_free(gradient->strip_colors, gradient->strips.size * sizeof(color_t));
+    gradient->strip_colors = NULL;
+  }
+  polygon_geometry_deinit(&(gradient->strips));
+
+  return RET_OK;
+}
+
+ret_t polygon_gradient_deinit(polygon_gradient_t* gradient) {
+  return_value_if_fail(gradient != NULL, RET_BAD_PARAMS);
+
+  polygon_gradient_reset_strips(gradient);
+  gradient->nr = 0;
+
+  return RET_OK;
+}
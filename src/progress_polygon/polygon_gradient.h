@@ -0,0 +1,140 @@
+﻿/**
+ * File:   polygon_gradient.h
+ * Author: AWTK Develop Team
+ * Brief:  沿进度方向的渐变色。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#ifndef TK_POLYGON_GRADIENT_H
+#define TK_POLYGON_GRADIENT_H
+
+#include "tkc/color.h"
+#include "polygon_geometry.h"
+
+BEGIN_C_DECLS
+
+#define POLYGON_GRADIENT_MAX_STOPS 8
+
+/**
+ * @class polygon_gradient_t
+ * 沿进度方向的渐变色。
+ *
+ * 颜色由进度(点的 value)决定，而不是由屏幕坐标决定。描述格式为 "[位置:]颜色;[位置:]颜色..."，
+ * 位置取值 0-1，省略时均匀分布。如："#2196F3;#FFC107;#F44336" 或 "0:blue;0.8:gold;1:red"。
+ *
+ * 创建条带时，在几何数据中插入渐变色的关键点，并为每个点预先计算好颜色，修改进度不需要重新计算。
+ * 绘制时同一个关键点区间内的条带合并成一段，每段只填充一次。
+ */
+typedef struct _polygon_gradient_t {
+  /**
+   * @property {uint32_t} nr
+   * 关键点的个数。
+   */
+  uint32_t nr;
+  float stops[POLYGON_GRADIENT_MAX_STOPS];
+  color_t colors[POLYGON_GRADIENT_MAX_STOPS];
+
+  /*插入关键点后的几何数据，以及每个点的颜色*/
+  polygon_geometry_t strips;
+  color_t* strip_colors;
+} polygon_gradient_t;
+
+/**
+ * @method polygon_gradient_init
+ * 解析渐变色描述。
+ * @param {polygon_gradient_t*} gradient 渐变色。
+ * @param {const char*} str 渐变色描述。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_gradient_init(polygon_gradient_t* gradient, const char* str);
+
+/**
+ * @method polygon_gradient_get_color
+ * 获取进度为 progress 时的颜色。
+ * @param {const polygon_gradient_t*} gradient 渐变色。
+ * @param {float} progress 进度(0-1)。
+ *
+ * @return {color_t} 返回颜色。
+ */
+color_t polygon_gradient_get_color(const polygon_gradient_t* gradient, float progress);
+
+/**
+ * @method polygon_gradient_build_strips
+ * 根据几何数据创建条带，并预先计算每个点的颜色。
+ * @param {polygon_gradient_t*} gradient 渐变色。
+ * @param {const polygon_geometry_t*} geo 几何数据。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_gradient_build_strips(polygon_gradient_t* gradient, const polygon_geometry_t* geo);
+
+/**
+ * @method polygon_gradient_update_strips
+ * 几何数据的坐标变化(如变形动画的每一帧)后，在原来的内存中重新计算条带。
+ * 条带的个数发生变化或者还没有创建时，等同于 polygon\_gradient\_build\_strips。
+ * @param {polygon_gradient_t*} gradient 渐变色。
+ * @param {const polygon_geometry_t*} geo 几何数据。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_gradient_update_strips(polygon_gradient_t* gradient, const polygon_geometry_t* geo);
+
+/**
+ * @method polygon_gradient_get_run_end
+ * 获取从第 start 个点开始、可以用一次线性渐变填充的一段条带的终点。
+ *
+ * 到下一个关键点为止。中心线转过的角度超过 60 度时(如圆环)提前结束，
+ * 保证线性渐变的方向和进度的方向基本一致。
+ * @param {const polygon_gradient_t*} gradient 渐变色。
+ * @param {uint32_t} start 起点的序号。
+ *
+ * @return {uint32_t} 返回终点的序号。
+ */
+uint32_t polygon_gradient_get_run_end(const polygon_gradient_t* gradient, uint32_t start);
+
+/**
+ * @method polygon_gradient_has_strips
+ * 检查条带是否已经创建。
+ * @param {const polygon_gradient_t*} gradient 渐变色。
+ *
+ * @return {bool_t} 返回TRUE表示已经创建。
+ */
+bool_t polygon_gradient_has_strips(const polygon_gradient_t* gradient);
+
+/**
+ * @method polygon_gradient_reset_strips
+ * 释放条带(几何数据变化后调用)。
+ * @param {polygon_gradient_t*} gradient 渐变色。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_gradient_reset_strips(polygon_gradient_t* gradient);
+
+/**
+ * @method polygon_gradient_deinit
+ * 释放渐变色。
+ * @param {polygon_gradient_t*} gradient 渐变色。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_gradient_deinit(polygon_gradient_t* gradient);
+
+END_C_DECLS
+
+#endif /*TK_POLYGON_GRADIENT_H*/
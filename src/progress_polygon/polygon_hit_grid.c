@@ -0,0 +1,357 @@
+﻿/**
+ * File:   polygon_hit_grid.c
+ * Author: AWTK Develop Team
+ * Brief:  点击测试用的均匀网格索引。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "polygon_hit_grid.h"
+
+#define POLYGON_HIT_GRID_MAX_CELLS 16384
+#define POLYGON_HIT_GRID_EPSILON 0.0001f
+
+ret_t polygon_hit_grid_init(polygon_hit_grid_t* grid) {
+  return_value_if_fail(grid != NULL, RET_BAD_PARAMS);
+
+  memset(grid, 0x00, sizeof(polygon_hit_grid_t));
+
+  return RET_OK;
+}
+
+static void polygon_hit_grid_quad_bounds(const polygon_geometry_t* geo, uint32_t i, float* l,
+                                         float* t, float* r, float* b) {
+  *l = tk_min(tk_min(geo->x1[i], geo->x2[i]), tk_min(geo->x1[i + 1], geo->x2[i + 1]));
+  *r = tk_max(tk_max(geo->x1[i], geo->x2[i]), tk_max(geo->x1[i + 1], geo->x2[i + 1]));
+  *t = tk_min(tk_min(geo->y1[i], geo->y2[i]), tk_min(geo->y1[i + 1], geo->y2[i + 1]));
+  *b = tk_max(tk_max(geo->y1[i], geo->y2[i]), tk_max(geo->y1[i + 1], geo->y2[i + 1]));
+}
+
+static bool_t polygon_triangle_separated(float ax, float ay, float bx, float by, float cx, float cy,
+                                         float l, float t, float r, float b) {
+  /*以边 a-b 的法线为分离轴，c 在一侧，单元的四个角都在另一侧则分离*/
+  float nx = ay - by;
+  float ny = bx - ax;
+  float base = nx * ax + ny * ay;
+  float side = nx * cx + ny * cy - base;
+  float d0 = nx * l + ny * t - base;
+  float d1 = nx * r + ny * t - base;
+  float d2 = nx * l + ny * b - base;
+  float d3 = nx * r + ny * b - base;
+
+  if (side >= 0) {
+    return d0 < 0 && d1 < 0 && d2 < 0 && d3 < 0;
+  } else {
+    return d0 > 0 && d1 > 0 && d2 > 0 && d3 > 0;
+  }
+}
+
+static bool_t polygon_triangle_overlap(float ax, float ay, float bx, float by, float cx, float cy,
+                                       float l, float t, float r, float b) {
+  if (tk_max(tk_max(ax, bx), cx) < l || tk_min(tk_min(ax, bx), cx) > r ||
+      tk_max(tk_max(ay, by), cy) < t || tk_min(tk_min(ay, by), cy) > b) {
+    return FALSE;
+  }
+
+  return !polygon_triangle_separated(ax, ay, bx, by, cx, cy, l, t, r, b) &&
+         !polygon_triangle_separated(bx, by, cx, cy, ax, ay, l, t, r, b) &&
+         !polygon_triangle_separated(cx, cy, ax, ay, bx, by, l, t, r, b);
+}
+
+/*四个点中任取三个构成的四个三角形覆盖了四边形的凸包，用它们做保守的相交测试*/
+static bool_t polygon_quad_overlap(const polygon_geometry_t* geo, uint32_t i, float l, float t,
+                                   float r, float b) {
+  float px[4] = {geo->x1[i], geo->x2[i], geo->x2[i + 1], geo->x1[i + 1]};
+  float py[4] = {geo->y1[i], geo->y2[i], geo->y2[i + 1], geo->y1[i + 1]};
+
+  return polygon_triangle_overlap(px[0], py[0], px[1], py[1], px[2], py[2], l, t, r, b) ||
+         polygon_triangle_overlap(px[0], py[0], px[2], py[2], px[3], py[3], l, t, r, b) ||
+         polygon_triangle_overlap(px[0], py[0], px[1], py[1], px[3], py[3], l, t, r, b) ||
+         polygon_triangle_overlap(px[1], py[1], px[2], py[2], px[3], py[3], l, t, r, b);
+}
+
+static float polygon_quad_area(const polygon_geometry_t* geo, uint32_t i) {
+  float area = (geo->x1[i] * geo->y2[i] - geo->x2[i] * geo->y1[i]) +
+               (geo->x2[i] * geo->y2[i + 1] - geo->x2[i + 1] * geo->y2[i]) +
+               (geo->x2[i + 1] * geo->y1[i + 1] - geo->x1[i + 1] * geo->y2[i + 1]) +
+               (geo->x1[i + 1] * geo->y1[i] - geo->x1[i] * geo->y1[i + 1]);
+
+  return tk_abs(area) / 2;
+}
+
+static uint32_t polygon_hit_grid_col(const polygon_hit_grid_t* grid, float x) {
+  int32_t col = (int32_t)((x - grid->x) / grid->cell_w);
+
+  return tk_clamp(col, 0, (int32_t)grid->cols - 1);
+}
+
+static uint32_t polygon_hit_grid_row(const polygon_hit_grid_t* grid, float y) {
+  int32_t row = (int32_t)((y - grid->y) / grid->cell_h);
+
+  return tk_clamp(row, 0, (int32_t)grid->rows - 1);
+}
+
+static bool_t polygon_hit_grid_cell_overlap(const polygon_hit_grid_t* grid,
+                                            const polygon_geometry_t* geo, uint32_t i,
+                                            uint32_t col, uint32_t row) {
+  /*单元向外扩展一个像素，与查询时允许的误差一致*/
+  float l = grid->x + col * grid->cell_w - 1;
+  float t = grid->y + row * grid->cell_h - 1;
+  float r = l + grid->cell_w + 2;
+  float b = t + grid->cell_h + 2;
+
+  return polygon_quad_overlap(geo, i, l, t, r, b);
+}
+
+ret_t polygon_hit_grid_build(polygon_hit_grid_t* grid, const polygon_geometry_t* geo) {
+  uint32_t i = 0;
+  uint32_t col = 0;
+  uint32_t row = 0;
+  uint32_t nquads = 0;
+  uint32_t ncells = 0;
+  uint32_t* fill = NULL;
+  float l = 0, t = 0, r = 0, b = 0;
+  float min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+  float area = 0;
+  float cell = 0;
+  float cells = 0;
+  uint32_t limit = 0;
+  return_value_if_fail(grid != NULL && geo != NULL && geo->size > 1, RET_BAD_PARAMS);
+
+  polygon_hit_grid_deinit(grid);
+  nquads = geo->size - 1;
+
+  for (i = 0; i < nquads; i++) {
+    polygon_hit_grid_quad_bounds(geo, i, &l, &t, &r, &b);
+    if (i == 0) {
+      min_x = l;
+      min_y = t;
+      max_x = r;
+      max_y = b;
+    } else {
+      min_x = tk_min(min_x, l);
+      min_y = tk_min(min_y, t);
+      max_x = tk_max(max_x, r);
+      max_y = tk_max(max_y, b);
+    }
+    area += polygon_quad_area(geo, i);
+  }
+
+  /*单元大小与四边形的平均大小相当，每个单元中只有少数几个四边形，与点的总数无关*/
+  cell = tk_max(sqrtf(area / nquads), 1.0f);
+  limit = tk_min(nquads * 4 + 16, POLYGON_HIT_GRID_MAX_CELLS);
+  cells = ((max_x - min_x) / cell + 1) * ((max_y - min_y) / cell + 1);
+  if (cells > limit) {
+    cell *= sqrtf(cells / limit);
+  }
+
+  grid->x = min_x;
+  grid->y = min_y;
+  grid->cell_w = cell;
+  grid->cell_h = cell;
+  grid->cols = (uint32_t)((max_x - min_x) / cell) + 1;
+  grid->rows = (uint32_t)((max_y - min_y) / cell) + 1;
+  ncells = grid->cols * grid->rows;
+
+  grid->cells = TKMEM_ZALLOCN(uint32_t, ncells + 1);
+  fill = TKMEM_ZALLOCN(uint32_t, ncells);
+  goto_error_if_fail(grid->cells != NULL && fill != NULL);
+
+  for (i = 0; i < nquads; i++) {
+    polygon_hit_grid_quad_bounds(geo, i, &l, &t, &r, &b);
+    for (row = polygon_hit_grid_row(grid, t); row <= polygon_hit_grid_row(grid, b); row++) {
+      for (col = polygon_hit_grid_col(grid, l); col <= polygon_hit_grid_col(grid, r); col++) {
+        if (polygon_hit_grid_cell_overlap(grid, geo, i, col, row)) {
+          grid->cells[row * grid->cols + col + 1]++;
+        }
+      }
+    }
+  }
+
+  for (i = 0; i < ncells; i++) {
+    grid->cells[i + 1] += grid->cells[i];
+    fill[i] = grid->cells[i];
+  }
+
+  grid->quads = TKMEM_ZALLOCN(uint32_t, grid->cells[ncells] + 1);
+  goto_error_if_fail(grid->quads != NULL);
+
+  for (i = 0; i < nquads; i++) {
+    polygon_hit_grid_quad_bounds(geo, i, &l, &t, &r, &b);
+    for (row = polygon_hit_grid_row(grid, t); row <= polygon_hit_grid_row(grid, b); row++) {
+      for (col = polygon_hit_grid_col(grid, l); col <= polygon_hit_grid_col(grid, r); col++) {
+        if (polygon_hit_grid_cell_overlap(grid, geo, i, col, row)) {
+          grid->quads[fill[row * grid->cols + col]++] = i;
+        }
+      }
+    }
+  }
+
+  TKMEM_FREE(fill);
+
+  return RET_OK;
+error:
+  TKMEM_FREE(fill);
+  polygon_hit_grid_deinit(grid);
+
+  return RET_OOM;
+}
+
+bool_t polygon_hit_grid_is_empty(const polygon_hit_grid_t* grid) {
+  return grid == NULL || grid->cells == NULL;
+}
+
+static bool_t polygon_quad_check(const polygon_geometry_t* geo, uint32_t i, float x, float y,
+                                 float t) {
+  float s = 0;
+  float len2 = 0;
+  float dx = 0, dy = 0;
+  float qx = 0, qy = 0;
+  float x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+
+  if (t < -POLYGON_HIT_GRID_EPSILON || t > 1 + POLYGON_HIT_GRID_EPSILON) {
+    return FALSE;
+  }
+
+  t = tk_clamp(t, 0, 1);
+  x1 = geo->x1[i] + (geo->x1[i + 1] - geo->x1[i]) * t;
+  y1 = geo->y1[i] + (geo->y1[i + 1] - geo->y1[i]) * t;
+  x2 = geo->x2[i] + (geo->x2[i + 1] - geo->x2[i]) * t;
+  y2 = geo->y2[i] + (geo->y2[i + 1] - geo->y2[i]) * t;
+
+  dx = x2 - x1;
+  dy = y2 - y1;
+  qx = x - x1;
+  qy = y - y1;
+  len2 = dx * dx + dy * dy;
+  if (len2 < 1) {
+    /*分界线退化为一个点(如三角形的顶点)*/
+    return qx * qx + qy * qy <= 1;
+  }
+
+  /*允许半个像素的误差，这样点在边框上时也能命中*/
+  s = (qx * dx + qy * dy) / len2;
+  return s >= -0.5f / sqrtf(len2) && s <= 1 + 0.5f / sqrtf(len2);
+}
+
+/*
+ * 四边形的分界线为 P1(t)-P2(t)，其中 P1(t)、P2(t) 分别在两条边上随 t 线性变化。
+ * 点 P 在分界线上，等价于 cross(P2(t) - P1(t), P - P1(t)) = 0，这是关于 t 的二次方程。
+ */
+static ret_t polygon_quad_invert(const polygon_geometry_t* geo, uint32_t i, float x, float y,
+                                 float* t) {
+  float a = 0, b = 0, c = 0;
+  float e0x = geo->x2[i] - geo->x1[i];
+  float e0y = geo->y2[i] - geo->y1[i];
+  float d1x = geo->x1[i + 1] - geo->x1[i];
+  float d1y = geo->y1[i + 1] - geo->y1[i];
+  float dex = (geo->x2[i + 1] - geo->x1[i + 1]) - e0x;
+  float dey = (geo->y2[i + 1] - geo->y1[i + 1]) - e0y;
+  float q0x = x - geo->x1[i];
+  float q0y = y - geo->y1[i];
+
+  a = -(dex * d1y - dey * d1x);
+  b = (dex * q0y - dey * q0x) - (e0x * d1y - e0y * d1x);
+  c = e0x * q0y - e0y * q0x;
+
+  if (tk_abs(a) < POLYGON_HIT_GRID_EPSILON) {
+    if (tk_abs(b) < POLYGON_HIT_GRID_EPSILON) {
+      return RET_NOT_FOUND;
+    }
+
+    *t = -c / b;
+    return polygon_quad_check(geo, i, x, y, *t) ? RET_OK : RET_NOT_FOUND;
+  } else {
+    float q = 0;
+    float disc = b * b - 4 * a * c;
+    if (disc < 0) {
+      return RET_NOT_FOUND;
+    }
+
+    q = -0.5f * (b + (b < 0 ? -sqrtf(disc) : sqrtf(disc)));
+    *t = q / a;
+    if (polygon_quad_check(geo, i, x, y, *t)) {
+      return RET_OK;
+    }
+
+    if (tk_abs(q) > POLYGON_HIT_GRID_EPSILON) {
+      *t = c / q;
+      if (polygon_quad_check(geo, i, x, y, *t)) {
+        return RET_OK;
+      }
+    }
+  }
+
+  return RET_NOT_FOUND;
+}
+
+ret_t polygon_hit_grid_query(const polygon_hit_grid_t* grid, const polygon_geometry_t* geo,
+                             float x, float y, float hint, float* progress) {
+  uint32_t i = 0;
+  uint32_t end = 0;
+  uint32_t cell = 0;
+  uint32_t quad = 0;
+  float t = 0;
+  float p = 0;
+  bool_t found = FALSE;
+  return_value_if_fail(!polygon_hit_grid_is_empty(grid), RET_BAD_PARAMS);
+  return_value_if_fail(geo != NULL && geo->size > 1 && progress != NULL, RET_BAD_PARAMS);
+
+  if (x < grid->x - 1 || y < grid->y - 1 || x > grid->x + grid->cols * grid->cell_w + 1 ||
+      y > grid->y + grid->rows * grid->cell_h + 1) {
+    return RET_NOT_FOUND;
+  }
+
+  cell = polygon_hit_grid_row(grid, y) * grid->cols + polygon_hit_grid_col(grid, x);
+  end = grid->cells[cell + 1];
+  for (i = grid->cells[cell]; i < end; i++) {
+    quad = grid->quads[i];
+    if (polygon_quad_invert(geo, quad, x, y, &t) == RET_OK) {
+      t = tk_clamp(t, 0, 1);
+      p = geo->values[quad] + (geo->values[quad + 1] - geo->values[quad]) * t;
+      if (!found || tk_abs(p - hint) < tk_abs(*progress - hint)) {
+        *progress = p;
+      }
+      found = TRUE;
+    }
+  }
+
+  return found ? RET_OK : RET_NOT_FOUND;
+}
+
+uint32_t polygon_hit_grid_get_mem_size(const polygon_hit_grid_t* grid) {
+  return_value_if_fail(grid != NULL, 0);
+
+  if (polygon_hit_grid_is_empty(grid)) {
+    return 0;
+  }
+
+  return (grid->cols * grid->rows + 1 + grid->cells[grid->cols * grid->rows] + 1) *
+         sizeof(uint32_t);
+}
+
+ret_t polygon_hit_grid_deinit(polygon_hit_grid_t* grid) {
+  return_value_if_fail(grid != NULL, RET_BAD_PARAMS);
+
+  TKMEM_FREE(grid->cells);
+  TKMEM_FREE(grid->quads);
+  memset(grid, 0x00, sizeof(polygon_hit_grid_t));
+
+  return RET_OK;
+}
@@ -0,0 +1,123 @@
+﻿/**
+ * File:   polygon_hit_grid.h
+ * Author: AWTK Develop Team
+ * Brief:  点击测试用的均匀网格索引。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#ifndef TK_POLYGON_HIT_GRID_H
+#define TK_POLYGON_HIT_GRID_H
+
+#include "polygon_geometry.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class polygon_hit_grid_t
+ * 点击测试用的均匀网格索引。
+ *
+ * 相邻两个点构成一个四边形，网格的每个单元记录与它的包围盒相交的四边形，
+ * 查询时只需要检查点所在单元中的少量四边形，与点的个数无关。
+ */
+typedef struct _polygon_hit_grid_t {
+  /**
+   * @property {uint32_t} cols
+   * 列数。
+   */
+  uint32_t cols;
+  /**
+   * @property {uint32_t} rows
+   * 行数。
+   */
+  uint32_t rows;
+
+  float x;
+  float y;
+  float cell_w;
+  float cell_h;
+  /*cells[i] 到 cells[i+1] 之间为第 i 个单元中的四边形*/
+  uint32_t* cells;
+  uint32_t* quads;
+} polygon_hit_grid_t;
+
+/**
+ * @method polygon_hit_grid_init
+ * 初始化。
+ * @param {polygon_hit_grid_t*} grid 网格索引。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_hit_grid_init(polygon_hit_grid_t* grid);
+
+/**
+ * @method polygon_hit_grid_build
+ * 根据几何数据创建网格索引。
+ * @param {polygon_hit_grid_t*} grid 网格索引。
+ * @param {const polygon_geometry_t*} geo 几何数据。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_hit_grid_build(polygon_hit_grid_t* grid, const polygon_geometry_t* geo);
+
+/**
+ * @method polygon_hit_grid_is_empty
+ * 检查网格索引是否还没有创建。
+ * @param {const polygon_hit_grid_t*} grid 网格索引。
+ *
+ * @return {bool_t} 返回TRUE表示没有创建。
+ */
+bool_t polygon_hit_grid_is_empty(const polygon_hit_grid_t* grid);
+
+/**
+ * @method polygon_hit_grid_query
+ * 查找包含点(x, y)的四边形，并反算出对应的进度。
+ *
+ * > 多个四边形重叠时，返回最接近 hint 的进度。
+ * @param {const polygon_hit_grid_t*} grid 网格索引。
+ * @param {const polygon_geometry_t*} geo 几何数据(必须是创建索引时的几何数据)。
+ * @param {float} x x坐标(像素)。
+ * @param {float} y y坐标(像素)。
+ * @param {float} hint 参考进度(0-1)。
+ * @param {float*} progress 返回进度(0-1)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，RET_NOT_FOUND表示点不在多边形内。
+ */
+ret_t polygon_hit_grid_query(const polygon_hit_grid_t* grid, const polygon_geometry_t* geo,
+                             float x, float y, float hint, float* progress);
+
+/**
+ * @method polygon_hit_grid_get_mem_size
+ * 获取占用的内存(字节)。
+ * @param {const polygon_hit_grid_t*} grid 网格索引。
+ *
+ * @return {uint32_t} 返回占用的内存。
+ */
+uint32_t polygon_hit_grid_get_mem_size(const polygon_hit_grid_t* grid);
+
+/**
+ * @method polygon_hit_grid_deinit
+ * 释放网格索引。
+ * @param {polygon_hit_grid_t*} grid 网格索引。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_hit_grid_deinit(polygon_hit_grid_t* grid);
+
+END_C_DECLS
+
+#endif /*TK_POLYGON_HIT_GRID_H*/
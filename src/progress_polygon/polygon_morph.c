@@ -0,0 +1,153 @@
+﻿/**
+ * File:   polygon_morph.c
+ * Author: AWTK Develop Team
+ * Brief:  多边形变形(在两个形状之间插值)。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "polygon_morph.h"
+
+#define POLYGON_MORPH_EPSILON 0.000001f
+#define POLYGON_MORPH_END 1e30f
+
+static void polygon_morph_sample(const polygon_geometry_t* geo, uint32_t index, float value,
+                                 bool_t exact, float* out, uint32_t stride) {
+  uint32_t offset = 0;
+  polygon_point_t p;
+
+  if (exact) {
+    p.x1 = geo->x1[index];
+    p.y1 = geo->y1[index];
+    p.x2 = geo->x2[index];
+    p.y2 = geo->y2[index];
+  } else {
+    polygon_geometry_get_boundary(geo, value, &offset, &p);
+  }
+
+  out[0] = value;
+  out[stride] = p.x1;
+  out[stride * 2] = p.y1;
+  out[stride * 3] = p.x2;
+  out[stride * 4] = p.y2;
+}
+
+/*
+ * 按 value 合并两组点，相同的 value 只保留一次(重复的点按出现的次数配对)，
+ * to 为 NULL 时只计数。
+ */
+static uint32_t polygon_morph_merge(const polygon_geometry_t* from, const polygon_geometry_t* to,
+                                    float* out_from, float* out_to, uint32_t stride) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t n = 0;
+
+  while (i < from->size || j < to->size) {
+    float fv = i < from->size ? from->values[i] : POLYGON_MORPH_END;
+    float tv = j < to->size ? to->values[j] : POLYGON_MORPH_END;
+
+    if (out_from != NULL) {
+      if (tk_abs(fv - tv) < POLYGON_MORPH_EPSILON) {
+        polygon_morph_sample(from, i, fv, TRUE, out_from + n, stride);
+        polygon_morph_sample(to, j, fv, TRUE, out_to + n, stride);
+      } else if (fv < tv) {
+        polygon_morph_sample(from, i, fv, TRUE, out_from + n, stride);
+        polygon_morph_sample(to, j, fv, FALSE, out_to + n, stride);
+      } else {
+        polygon_morph_sample(from, i, tv, FALSE, out_from + n, stride);
+        polygon_morph_sample(to, j, tv, TRUE, out_to + n, stride);
+      }
+    }
+
+    if (tk_abs(fv - tv) < POLYGON_MORPH_EPSILON) {
+      i++;
+      j++;
+    } else if (fv < tv) {
+      i++;
+    } else {
+      j++;
+    }
+    n++;
+  }
+
+  return n;
+}
+
+ret_t polygon_morph_init(polygon_morph_t* morph, const polygon_geometry_t* from,
+                         const polygon_geometry_t* to) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+  float* data = NULL;
+  return_value_if_fail(morph != NULL && from != NULL && to != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(from->size > 0 && to->size > 0, RET_BAD_PARAMS);
+
+  memset(morph, 0x00, sizeof(polygon_morph_t));
+  n = polygon_morph_merge(from, to, NULL, NULL, 0);
+  data = TKMEM_ZALLOCN(float, n * 5 * 2);
+  return_value_if_fail(data != NULL, RET_OOM);
+
+  morph->size = n;
+  morph->from = data;
+  morph->delta = data + n * 5;
+  polygon_morph_merge(from, to, morph->from, morph->delta, n);
+
+  for (i = 0; i < n * 5; i++) {
+    morph->delta[i] -= morph->from[i];
+  }
+
+  return RET_OK;
+}
+
+ret_t polygon_morph_step(const polygon_morph_t* morph, float t, polygon_geometry_t* geo) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+  float* out = NULL;
+  const float* from = NULL;
+  const float* delta = NULL;
+  return_value_if_fail(morph != NULL && morph->from != NULL && geo != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(polygon_geometry_ensure_size(geo, morph->size) == RET_OK, RET_OOM);
+
+  n = morph->size * 5;
+  out = geo->values;
+  from = morph->from;
+  delta = morph->delta;
+
+  /*五列连续存放，一个循环完成全部插值，便于编译器向量化*/
+  for (i = 0; i < n; i++) {
+    out[i] = from[i] + delta[i] * t;
+  }
+
+  return RET_OK;
+}
+
+uint32_t polygon_morph_get_mem_size(const polygon_morph_t* morph) {
+  return_value_if_fail(morph != NULL, 0);
+
+  /*from 和 delta 在同一块内存中*/
+  return morph->size * 5 * 2 * sizeof(float);
+}
+
+ret_t polygon_morph_deinit(polygon_morph_t* morph) {
+  return_value_if_fail(morph != NULL, RET_BAD_PARAMS);
+
+  TKMEM_FREE(morph->from);
+  memset(morph, 0x00, sizeof(polygon_morph_t));
+
+  return RET_OK;
+}
@@ -0,0 +1,92 @@
+﻿/**
+ * File:   polygon_morph.h
+ * Author: AWTK Develop Team
+ * Brief:  多边形变形(在两个形状之间插值)。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#ifndef TK_POLYGON_MORPH_H
+#define TK_POLYGON_MORPH_H
+
+#include "polygon_geometry.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class polygon_morph_t
+ * 多边形变形。
+ *
+ * 创建时把起始形状和目标形状重新采样到相同的点(两者 value 的并集)，
+ * 之后每一帧只需要对连续存放的坐标做一次线性插值，不需要再解析或分配内存。
+ */
+typedef struct _polygon_morph_t {
+  /**
+   * @property {uint32_t} size
+   * 重新采样后点的个数。
+   */
+  uint32_t size;
+
+  /*与 polygon_geometry_t 的布局相同(values/x1/y1/x2/y2 各 size 个)*/
+  float* from;
+  float* delta;
+} polygon_morph_t;
+
+/**
+ * @method polygon_morph_init
+ * 初始化。
+ * @param {polygon_morph_t*} morph 变形对象。
+ * @param {const polygon_geometry_t*} from 起始形状。
+ * @param {const polygon_geometry_t*} to 目标形状。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_morph_init(polygon_morph_t* morph, const polygon_geometry_t* from,
+                         const polygon_geometry_t* to);
+
+/**
+ * @method polygon_morph_step
+ * 计算变形到 t 时的形状。
+ * @param {const polygon_morph_t*} morph 变形对象。
+ * @param {float} t 进度(0-1)。
+ * @param {polygon_geometry_t*} geo 返回形状。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_morph_step(const polygon_morph_t* morph, float t, polygon_geometry_t* geo);
+
+/**
+ * @method polygon_morph_get_mem_size
+ * 获取占用的内存(字节)。
+ * @param {const polygon_morph_t*} morph 变形对象。
+ *
+ * @return {uint32_t} 返回占用的内存。
+ */
+uint32_t polygon_morph_get_mem_size(const polygon_morph_t* morph);
+
+/**
+ * @method polygon_morph_deinit
+ * 释放变形对象。
+ * @param {polygon_morph_t*} morph 变形对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_morph_deinit(polygon_morph_t* morph);
+
+END_C_DECLS
+
+#endif /*TK_POLYGON_MORPH_H*/
@@ -0,0 +1,75 @@
+﻿/**
+ * File:   polygon_path.c
+ * Author: AWTK Develop Team
+ * Brief:  生成多边形的绘制路径。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#include "tkc/utils.h"
+#include "polygon_path.h"
+
+ret_t polygon_path_add_range(vgcanvas_t* vg, const polygon_geometry_t* geo, float dx, float dy,
+                             uint32_t from_offset, const polygon_point_t* from, uint32_t to_offset,
+                             const polygon_point_t* to) {
+  int32_t i = 0;
+  int32_t first = 0;
+  int32_t last = 0;
+  bool_t include_to = FALSE;
+  return_value_if_fail(vg != NULL && geo != NULL && geo->size > 0, RET_BAD_PARAMS);
+  return_value_if_fail(from != NULL && to != NULL, RET_BAD_PARAMS);
+
+  /*两条分界线之间的点，分界线正好落在点上时不重复*/
+  first = geo->values[from_offset] > from->value ? from_offset : from_offset + 1;
+  include_to = geo->values[to_offset] > to->value;
+  last = include_to ? to_offset : to_offset + 1;
+
+  vgcanvas_move_to(vg, dx + from->x1, dy + from->y1);
+  for (i = first; i < last; i++) {
+    vgcanvas_line_to(vg, dx + geo->x1[i], dy + geo->y1[i]);
+  }
+
+  if (include_to) {
+    vgcanvas_line_to(vg, dx + to->x1, dy + to->y1);
+    vgcanvas_line_to(vg, dx + to->x2, dy + to->y2);
+  }
+
+  for (i = last - 1; i >= first; i--) {
+    vgcanvas_line_to(vg, dx + geo->x2[i], dy + geo->y2[i]);
+  }
+  vgcanvas_line_to(vg, dx + from->x2, dy + from->y2);
+  vgcanvas_close_path(vg);
+
+  return RET_OK;
+}
+
+ret_t polygon_path_add_outline(vgcanvas_t* vg, const polygon_geometry_t* geo, float dx, float dy) {
+  int32_t i = 0;
+  return_value_if_fail(vg != NULL && geo != NULL && geo->size > 0, RET_BAD_PARAMS);
+
+  vgcanvas_move_to(vg, dx + geo->x1[0], dy + geo->y1[0]);
+  for (i = 1; i < geo->size; i++) {
+    vgcanvas_line_to(vg, dx + geo->x1[i], dy + geo->y1[i]);
+  }
+
+  for (i = geo->size - 1; i >= 0; i--) {
+    vgcanvas_line_to(vg, dx + geo->x2[i], dy + geo->y2[i]);
+  }
+  vgcanvas_close_path(vg);
+
+  return RET_OK;
+}
@@ -0,0 +1,67 @@
+﻿/**
+ * File:   polygon_path.h
+ * Author: AWTK Develop Team
+ * Brief:  生成多边形的绘制路径。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#ifndef TK_POLYGON_PATH_H
+#define TK_POLYGON_PATH_H
+
+#include "base/vgcanvas.h"
+#include "polygon_geometry.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @method polygon_path_add_range
+ * 把进度在两条分界线之间的部分作为一个封闭的子路径添加到当前路径中。
+ *
+ * > 不会调用 vgcanvas\_begin\_path，多个子路径可以合并到一个路径中一次填充。
+ * @annotation ["global"]
+ * @param {vgcanvas_t*} vg vgcanvas对象。
+ * @param {const polygon_geometry_t*} geo 几何数据。
+ * @param {float} dx x方向的偏移。
+ * @param {float} dy y方向的偏移。
+ * @param {uint32_t} from_offset 起始分界线对应的 polygon\_geometry\_find 的结果。
+ * @param {const polygon_point_t*} from 起始分界线。
+ * @param {uint32_t} to_offset 结束分界线对应的 polygon\_geometry\_find 的结果。
+ * @param {const polygon_point_t*} to 结束分界线。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_path_add_range(vgcanvas_t* vg, const polygon_geometry_t* geo, float dx, float dy,
+                             uint32_t from_offset, const polygon_point_t* from, uint32_t to_offset,
+                             const polygon_point_t* to);
+
+/**
+ * @method polygon_path_add_outline
+ * 把多边形的轮廓作为一个封闭的子路径添加到当前路径中(不会调用 vgcanvas\_begin\_path)。
+ * @annotation ["global"]
+ * @param {vgcanvas_t*} vg vgcanvas对象。
+ * @param {const polygon_geometry_t*} geo 几何数据。
+ * @param {float} dx x方向的偏移。
+ * @param {float} dy y方向的偏移。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_path_add_outline(vgcanvas_t* vg, const polygon_geometry_t* geo, float dx, float dy);
+
+END_C_DECLS
+
+#endif /*TK_POLYGON_PATH_H*/
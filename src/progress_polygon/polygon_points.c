@@ -0,0 +1,172 @@
+﻿/**
+ * File:   polygon_points.c
+ * Author: AWTK Develop Team
+ * Brief:  多边形描述。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "polygon_pool.h"
+#include "polygon_points.h"
+
+/*解析一个元组 "(value, x1, y1, x2, y2)"，返回 NULL 表示后面没有更多的元组*/
+static const char* polygon_parse_tuple(const char* p, float* v) {
+  p = tk_skip_chars(p, " ");
+  v[0] = tk_atof(p + 1);
+
+  p = tk_skip_to_chars(p, ",");
+  return_value_if_fail(*p == ',', NULL);
+  p = tk_skip_chars(p, " ");
+  v[1] = tk_atof(p + 1);
+
+  p = tk_skip_to_chars(p + 1, ",");
+  return_value_if_fail(*p == ',', NULL);
+  p = tk_skip_chars(p, " ");
+  v[2] = tk_atof(p + 1);
+
+  p = tk_skip_to_chars(p + 1, ",");
+  return_value_if_fail(*p == ',', NULL);
+  p = tk_skip_chars(p, " ");
+  v[3] = tk_atof(p + 1);
+
+  p = tk_skip_to_chars(p + 1, ",");
+  return_value_if_fail(*p == ',', NULL);
+  p = tk_skip_chars(p, " ");
+  v[4] = tk_atof(p + 1);
+
+  p = tk_skip_to_chars(p + 1, ")");
+  return_value_if_fail(*p == ')', NULL);
+
+  return p;
+}
+
+static ret_t polygon_stations_shrink(polygon_stations_t* stations, uint32_t size) {
+  uint32_t i = 0;
+  float* data = NULL;
+
+  data = (float*)polygon_pool_alloc(size * 5 * sizeof(float));
+  if (data == NULL) {
+    polygon_stations_deinit(stations);
+    return RET_OOM;
+  }
+
+  /*按列存放，每一列都要移到新的位置*/
+  for (i = 0; i < 5; i++) {
+    memcpy(data + i * size, stations->data + i * stations->size, size * sizeof(float));
+  }
+
+  polygon_pool_free(stations->data, stations->size * 5 * sizeof(float));
+  stations->data = data;
+  stations->size = size;
+
+  return RET_OK;
+}
+
+ret_t polygon_stations_init(polygon_stations_t* stations, const char* data) {
+  const char* p = data;
+  uint32_t n = 0;
+  uint32_t i = 0;
+  float v[5];
+  return_value_if_fail(stations != NULL && data != NULL, RET_BAD_PARAMS);
+
+  memset(stations, 0x00, sizeof(polygon_stations_t));
+  n = tk_count_char(data, '(');
+  if (n == 0) {
+    return RET_OK;
+  }
+
+  stations->data = (float*)polygon_pool_alloc(n * 5 * sizeof(float));
+  return_value_if_fail(stations->data != NULL, RET_OOM);
+  stations->size = n;
+
+  do {
+    p = tk_skip_to_chars(p, "(");
+    if (p == NULL || *p == '\0') break;
+
+    memset(v, 0x00, sizeof(v));
+    p = polygon_parse_tuple(p, v);
+    POLYGON_STATIONS_VALUES(stations)[i] = v[0];
+    POLYGON_STATIONS_X1(stations)[i] = v[1];
+    POLYGON_STATIONS_Y1(stations)[i] = v[2];
+    POLYGON_STATIONS_X2(stations)[i] = v[3];
+    POLYGON_STATIONS_Y2(stations)[i] = v[4];
+    i++;
+  } while (p != NULL && i < n);
+
+  if (i == 0) {
+    polygon_stations_deinit(stations);
+    return RET_BAD_PARAMS;
+  }
+
+  /*格式错误时解析提前结束，后面没有填写的点不能保留*/
+  if (i < n) {
+    return polygon_stations_shrink(stations, i);
+  }
+
+  return RET_OK;
+}
+
+ret_t polygon_stations_copy(polygon_stations_t* stations, const polygon_stations_t* other) {
+  return_value_if_fail(stations != NULL && other != NULL, RET_BAD_PARAMS);
+
+  memset(stations, 0x00, sizeof(polygon_stations_t));
+  if (other->size == 0) {
+    return RET_OK;
+  }
+
+  stations->data = (float*)polygon_pool_alloc(other->size * 5 * sizeof(float));
+  return_value_if_fail(stations->data != NULL, RET_OOM);
+  stations->size = other->size;
+  memcpy(stations->data, other->data, other->size * 5 * sizeof(float));
+
+  return RET_OK;
+}
+
+ret_t polygon_stations_to_str(const polygon_stations_t* stations, str_t* str) {
+  uint32_t i = 0;
+  return_value_if_fail(stations != NULL && str != NULL, RET_BAD_PARAMS);
+
+  str_clear(str);
+  for (i = 0; i < stations->size; i++) {
+    /*%.9g 可以无损地还原 float*/
+    str_append_format(str, 128, "(%.9g,%.9g,%.9g,%.9g,%.9g)",
+                      POLYGON_STATIONS_VALUES(stations)[i], POLYGON_STATIONS_X1(stations)[i],
+                      POLYGON_STATIONS_Y1(stations)[i], POLYGON_STATIONS_X2(stations)[i],
+                      POLYGON_STATIONS_Y2(stations)[i]);
+  }
+
+  return RET_OK;
+}
+
+uint32_t polygon_stations_get_mem_size(const polygon_stations_t* stations) {
+  return_value_if_fail(stations != NULL, 0);
+
+  return stations->size > 0 ? polygon_pool_block_size(stations->size * 5 * sizeof(float)) : 0;
+}
+
+ret_t polygon_stations_deinit(polygon_stations_t* stations) {
+  return_value_if_fail(stations != NULL, RET_BAD_PARAMS);
+
+  if (stations->data != NULL) {
+    polygon_pool_free(stations->data, stations->size * 5 * sizeof(float));
+  }
+  memset(stations, 0x00, sizeof(polygon_stations_t));
+
+  return RET_OK;
+}
@@ -0,0 +1,114 @@
+﻿/**
+ * File:   polygon_points.h
+ * Author: AWTK Develop Team
+ * Brief:  多边形描述。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#ifndef TK_POLYGON_POINTS_H
+#define TK_POLYGON_POINTS_H
+
+#include "tkc/str.h"
+
+BEGIN_C_DECLS
+
+typedef struct _polygon_point_t {
+  float value;
+  float x1;
+  float y1;
+  float x2;
+  float y2;
+} polygon_point_t;
+
+/*format [(0, 0, 0, 0, 30), (1, 100, 0, 100, 30)]*/
+
+/**
+ * @class polygon_stations_t
+ * 紧凑的多边形描述(控件长期保存的形式)。
+ *
+ * 按列(values/x1/y1/x2/y2)存放在一块从 polygon\_pool 分配的内存中，每个点只占 20 字节。
+ */
+typedef struct _polygon_stations_t {
+  /**
+   * @property {uint32_t} size
+   * 点的个数。
+   */
+  uint32_t size;
+  /*values/x1/y1/x2/y2 各 size 个*/
+  float* data;
+} polygon_stations_t;
+
+#define POLYGON_STATIONS_VALUES(s) ((s)->data)
+#define POLYGON_STATIONS_X1(s) ((s)->data + (s)->size)
+#define POLYGON_STATIONS_Y1(s) ((s)->data + (s)->size * 2)
+#define POLYGON_STATIONS_X2(s) ((s)->data + (s)->size * 3)
+#define POLYGON_STATIONS_Y2(s) ((s)->data + (s)->size * 4)
+
+/**
+ * @method polygon_stations_init
+ * 解析多边形描述。
+ *
+ * 遇到格式错误的元组时停止解析(该元组缺少的分量为0)，size 为实际解析出来的点数。没有任何点时 size 为 0。
+ * @param {polygon_stations_t*} stations 多边形描述。
+ * @param {const char*} data 多边形描述。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_stations_init(polygon_stations_t* stations, const char* data);
+
+/**
+ * @method polygon_stations_copy
+ * 复制多边形描述(如给后台线程使用的快照)。
+ * @param {polygon_stations_t*} stations 多边形描述。
+ * @param {const polygon_stations_t*} other 被复制的多边形描述。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_stations_copy(polygon_stations_t* stations, const polygon_stations_t* other);
+
+/**
+ * @method polygon_stations_to_str
+ * 重新生成多边形描述的字符串。
+ * @param {const polygon_stations_t*} stations 多边形描述。
+ * @param {str_t*} str 返回字符串。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_stations_to_str(const polygon_stations_t* stations, str_t* str);
+
+/**
+ * @method polygon_stations_get_mem_size
+ * 获取占用的内存(字节)。
+ * @param {const polygon_stations_t*} stations 多边形描述。
+ *
+ * @return {uint32_t} 返回占用的内存。
+ */
+uint32_t polygon_stations_get_mem_size(const polygon_stations_t* stations);
+
+/**
+ * @method polygon_stations_deinit
+ * 释放多边形描述。
+ * @param {polygon_stations_t*} stations 多边形描述。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_stations_deinit(polygon_stations_t* stations);
+
+END_C_DECLS
+
+#endif /*TK_POLYGON_POINTS_H*/
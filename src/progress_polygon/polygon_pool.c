@@ -0,0 +1,210 @@
+﻿/**
+ * File:   polygon_pool.c
+ * Author: AWTK Develop Team
+ * Brief:  点数据的共享内存池。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/mutex.h"
+#include "polygon_pool.h"
+
+#define POLYGON_POOL_ALIGN 16
+#define POLYGON_POOL_CLASSES 16
+#define POLYGON_POOL_CHUNK_SIZE 4096
+
+typedef struct _polygon_pool_block_t {
+  struct _polygon_pool_block_t* next;
+} polygon_pool_block_t;
+
+typedef struct _polygon_pool_chunk_t {
+  struct _polygon_pool_chunk_t* next;
+  /*按 POLYGON_POOL_ALIGN 对齐*/
+  uint8_t padding[POLYGON_POOL_ALIGN - sizeof(void*)];
+} polygon_pool_chunk_t;
+
+typedef struct _polygon_pool_impl_t {
+  polygon_pool_block_t* free_list[POLYGON_POOL_CLASSES];
+  polygon_pool_chunk_t* chunks;
+  uint8_t* cursor;
+  uint8_t* end;
+  uint32_t used;
+  uint32_t reserved;
+  tk_mutex_t* lock;
+  /*已经调用 polygon_pool_deinit，最后一块内存释放时归还全部大块内存*/
+  bool_t closing;
+} polygon_pool_impl_t;
+
+static polygon_pool_impl_t s_polygon_pool;
+
+static void polygon_pool_lock(polygon_pool_impl_t* pool) {
+  if (pool->lock != NULL) {
+    tk_mutex_lock(pool->lock);
+  }
+}
+
+static void polygon_pool_unlock(polygon_pool_impl_t* pool) {
+  if (pool->lock != NULL) {
+    tk_mutex_unlock(pool->lock);
+  }
+}
+
+static void polygon_pool_release(polygon_pool_impl_t* pool) {
+  polygon_pool_chunk_t* iter = pool->chunks;
+
+  while (iter != NULL) {
+    polygon_pool_chunk_t* next = iter->next;
+    TKMEM_FREE(iter);
+    iter = next;
+  }
+
+  memset(pool->free_list, 0x00, sizeof(pool->free_list));
+  pool->chunks = NULL;
+  pool->cursor = NULL;
+  pool->end = NULL;
+  pool->reserved = 0;
+  pool->closing = FALSE;
+}
+
+ret_t polygon_pool_init(void) {
+  polygon_pool_impl_t* pool = &s_polygon_pool;
+
+  if (pool->lock == NULL) {
+    pool->lock = tk_mutex_create();
+    return_value_if_fail(pool->lock != NULL, RET_OOM);
+  }
+
+  return RET_OK;
+}
+
+ret_t polygon_pool_deinit(void) {
+  polygon_pool_impl_t* pool = &s_polygon_pool;
+
+  if (pool->lock != NULL) {
+    tk_mutex_destroy(pool->lock);
+    pool->lock = NULL;
+  }
+
+  if (pool->used == 0) {
+    polygon_pool_release(pool);
+  } else {
+    /*控件可能在之后才销毁*/
+    pool->closing = TRUE;
+  }
+
+  return RET_OK;
+}
+
+uint32_t polygon_pool_block_size(uint32_t size) {
+  return (size + POLYGON_POOL_ALIGN - 1) / POLYGON_POOL_ALIGN * POLYGON_POOL_ALIGN;
+}
+
+static void* polygon_pool_carve(polygon_pool_impl_t* pool, uint32_t size) {
+  void* p = NULL;
+
+  if (pool->cursor == NULL || pool->cursor + size > pool->end) {
+    polygon_pool_chunk_t* chunk = (polygon_pool_chunk_t*)TKMEM_ALLOC(POLYGON_POOL_CHUNK_SIZE);
+    return_value_if_fail(chunk != NULL, NULL);
+
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    pool->cursor = (uint8_t*)(chunk + 1);
+    pool->end = (uint8_t*)chunk + POLYGON_POOL_CHUNK_SIZE;
+    pool->reserved += POLYGON_POOL_CHUNK_SIZE;
+  }
+
+  p = pool->cursor;
+  pool->cursor += size;
+
+  return p;
+}
+
+void* polygon_pool_alloc(uint32_t size) {
+  void* p = NULL;
+  uint32_t index = 0;
+  polygon_pool_impl_t* pool = &s_polygon_pool;
+  return_value_if_fail(size > 0, NULL);
+
+  size = polygon_pool_block_size(size);
+  index = size / POLYGON_POOL_ALIGN - 1;
+
+  if (index >= POLYGON_POOL_CLASSES) {
+    p = TKMEM_ALLOC(size);
+    return_value_if_fail(p != NULL, NULL);
+  }
+
+  polygon_pool_lock(pool);
+  if (p != NULL) {
+    pool->reserved += size;
+  } else if (pool->free_list[index] != NULL) {
+    p = pool->free_list[index];
+    pool->free_list[index] = pool->free_list[index]->next;
+  } else {
+    p = polygon_pool_carve(pool, size);
+  }
+
+  if (p != NULL) {
+    pool->used += size;
+  }
+  polygon_pool_unlock(pool);
+
+  return p;
+}
+
+ret_t polygon_pool_free(void* p, uint32_t size) {
+  uint32_t index = 0;
+  polygon_pool_block_t* block = (polygon_pool_block_t*)p;
+  polygon_pool_impl_t* pool = &s_polygon_pool;
+  return_value_if_fail(p != NULL && size > 0, RET_BAD_PARAMS);
+
+  size = polygon_pool_block_size(size);
+  index = size / POLYGON_POOL_ALIGN - 1;
+
+  polygon_pool_lock(pool);
+  if (index >= POLYGON_POOL_CLASSES) {
+    pool->reserved -= size;
+  } else {
+    block->next = pool->free_list[index];
+    pool->free_list[index] = block;
+  }
+  pool->used -= size;
+  polygon_pool_unlock(pool);
+
+  if (index >= POLYGON_POOL_CLASSES) {
+    TKMEM_FREE(p);
+  }
+
+  /*closing 只在没有后台线程时设置，这里不需要加锁*/
+  if (pool->closing && pool->used == 0) {
+    polygon_pool_release(pool);
+  }
+
+  return RET_OK;
+}
+
+ret_t polygon_pool_get_stat(polygon_pool_stat_t* stat) {
+  return_value_if_fail(stat != NULL, RET_BAD_PARAMS);
+
+  polygon_pool_lock(&s_polygon_pool);
+  stat->used = s_polygon_pool.used;
+  stat->reserved = s_polygon_pool.reserved;
+  polygon_pool_unlock(&s_polygon_pool);
+
+  return RET_OK;
+}
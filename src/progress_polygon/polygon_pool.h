@@ -0,0 +1,122 @@
+﻿/**
+ * File:   polygon_pool.h
+ * Author: AWTK Develop Team
+ * Brief:  点数据的共享内存池。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#ifndef TK_POLYGON_POOL_H
+#define TK_POLYGON_POOL_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class polygon_pool_t
+ * @annotation ["fake"]
+ * 点数据的共享内存池。
+ *
+ * 所有控件的点数据都从这里分配。小块内存按大小分类，从大块内存中切出来，释放后放回对应的空闲链表，
+ * 避免为每个控件单独调用 TKMEM_ALLOC 带来的管理开销和内存碎片。较大的块直接从系统分配。
+ *
+ * 后台线程也会分配几何数据，所以启动后台线程之前要调用 polygon\_pool\_init 创建锁，
+ * 后台线程停止之后调用 polygon\_pool\_deinit 销毁锁。
+ */
+
+/**
+ * @class polygon_pool_stat_t
+ * 内存池的统计信息。
+ */
+typedef struct _polygon_pool_stat_t {
+  /**
+   * @property {uint32_t} used
+   * 已经分配出去的字节数。
+   */
+  uint32_t used;
+  /**
+   * @property {uint32_t} reserved
+   * 内存池从系统申请的字节数(包括直接分配的大块)。
+   */
+  uint32_t reserved;
+} polygon_pool_stat_t;
+
+/**
+ * @method polygon_pool_init
+ * 创建内存池的锁(只能在 GUI 线程中、后台线程启动之前调用)。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_pool_init(void);
+
+/**
+ * @method polygon_pool_deinit
+ * 销毁内存池的锁，并把大块内存还给系统(只能在后台线程停止之后调用)。
+ *
+ * 如果还有内存没有释放(控件还没有销毁)，等最后一块内存释放时再还给系统。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_pool_deinit(void);
+
+/**
+ * @method polygon_pool_alloc
+ * 分配内存。
+ * @annotation ["static"]
+ * @param {uint32_t} size 字节数。
+ *
+ * @return {void*} 返回内存地址，失败返回NULL。
+ */
+void* polygon_pool_alloc(uint32_t size);
+
+/**
+ * @method polygon_pool_free
+ * 释放内存。
+ * @annotation ["static"]
+ * @param {void*} p 内存地址。
+ * @param {uint32_t} size 字节数(必须与分配时相同)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_pool_free(void* p, uint32_t size);
+
+/**
+ * @method polygon_pool_get_stat
+ * 获取统计信息。
+ * @annotation ["static"]
+ * @param {polygon_pool_stat_t*} stat 返回统计信息。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_pool_get_stat(polygon_pool_stat_t* stat);
+
+/**
+ * @method polygon_pool_block_size
+ * 获取实际占用的字节数(按分类的大小对齐)。
+ * @annotation ["static"]
+ * @param {uint32_t} size 字节数。
+ *
+ * @return {uint32_t} 返回实际占用的字节数。
+ */
+uint32_t polygon_pool_block_size(uint32_t size);
+
+END_C_DECLS
+
+#endif /*TK_POLYGON_POOL_H*/
@@ -0,0 +1,284 @@
+﻿/**
+ * File:   polygon_worker.c
+ * Author: AWTK Develop Team
+ * Brief:  在后台线程中准备几何数据的任务池。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#include "tkc/utils.h"
+#include "tkc/cond.h"
+#include "tkc/mutex.h"
+#include "tkc/thread.h"
+#include "base/timer.h"
+#include "polygon_pool.h"
+#include "polygon_worker.h"
+
+#define POLYGON_WORKER_DISPATCH_INTERVAL 16
+
+typedef struct _polygon_worker_impl_t {
+  tk_mutex_t* lock;
+  tk_cond_t* has_job;
+  tk_cond_t* all_done;
+  tk_thread_t* threads[POLYGON_WORKER_THREAD_NR];
+  uint32_t thread_nr;
+  bool_t quit;
+  /*线程创建失败(如平台不支持线程)，不再重复尝试*/
+  bool_t start_failed;
+
+  /*以下成员由 lock 保护*/
+  polygon_job_t* queue;
+  polygon_job_t* queue_tail;
+  polygon_job_t* done;
+  polygon_job_t* done_tail;
+  uint32_t unfinished;
+
+  /*以下成员只在 GUI 线程中访问*/
+  uint32_t pending;
+  uint32_t timer_id;
+} polygon_worker_impl_t;
+
+static polygon_worker_impl_t s_polygon_worker;
+
+static void polygon_worker_append(polygon_job_t** head, polygon_job_t** tail, polygon_job_t* job) {
+  job->next = NULL;
+  if (*tail != NULL) {
+    (*tail)->next = job;
+  } else {
+    *head = job;
+  }
+  *tail = job;
+}
+
+static void* polygon_worker_main(void* args) {
+  bool_t canceled = FALSE;
+  polygon_job_t* job = NULL;
+  polygon_worker_impl_t* worker = (polygon_worker_impl_t*)args;
+
+  tk_mutex_lock(worker->lock);
+  while (TRUE) {
+    job = worker->queue;
+    if (job == NULL) {
+      if (worker->quit) {
+        break;
+      }
+      tk_cond_wait(worker->has_job, worker->lock);
+      continue;
+    }
+
+    worker->queue = job->next;
+    if (worker->queue == NULL) {
+      worker->queue_tail = NULL;
+    }
+    canceled = job->canceled;
+    tk_mutex_unlock(worker->lock);
+
+    /*已经取消的任务不再执行，只交给 GUI 线程释放*/
+    if (!canceled) {
+      job->run(job);
+    }
+
+    tk_mutex_lock(worker->lock);
+    polygon_worker_append(&worker->done, &worker->done_tail, job);
+    worker->unfinished--;
+    if (worker->unfinished == 0) {
+      tk_cond_broadcast(worker->all_done);
+    }
+  }
+  tk_mutex_unlock(worker->lock);
+
+  return NULL;
+}
+
+static ret_t polygon_worker_start(polygon_worker_impl_t* worker) {
+  uint32_t i = 0;
+
+  if (worker->thread_nr > 0) {
+    return RET_OK;
+  }
+
+  if (worker->start_failed) {
+    return RET_NOT_IMPL;
+  }
+
+  /*内存池的锁要在后台线程开始分配之前创建*/
+  goto_error_if_fail(polygon_pool_init() == RET_OK);
+
+  worker->lock = tk_mutex_create();
+  worker->has_job = tk_cond_create();
+  worker->all_done = tk_cond_create();
+  goto_error_if_fail(worker->lock != NULL && worker->has_job != NULL && worker->all_done != NULL);
+
+  worker->quit = FALSE;
+  for (i = 0; i < POLYGON_WORKER_THREAD_NR; i++) {
+    tk_thread_t* thread = tk_thread_create(polygon_worker_main, worker);
+    if (thread == NULL) {
+      break;
+    }
+
+    tk_thread_set_name(thread, "polygon_worker");
+    if (tk_thread_start(thread) != RET_OK) {
+      tk_thread_destroy(thread);
+      break;
+    }
+    worker->threads[worker->thread_nr++] = thread;
+  }
+  goto_error_if_fail(worker->thread_nr > 0);
+
+  return RET_OK;
+error:
+  polygon_worker_deinit();
+  worker->start_failed = TRUE;
+
+  return RET_NOT_IMPL;
+}
+
+static ret_t polygon_worker_on_timer(const timer_info_t* info) {
+  polygon_worker_impl_t* worker = (polygon_worker_impl_t*)(info->ctx);
+
+  polygon_worker_dispatch();
+  if (worker->pending == 0) {
+    worker->timer_id = TK_INVALID_ID;
+    return RET_REMOVE;
+  }
+
+  return RET_REPEAT;
+}
+
+ret_t polygon_worker_submit(polygon_job_t* job) {
+  polygon_worker_impl_t* worker = &s_polygon_worker;
+  return_value_if_fail(job != NULL && job->run != NULL && job->on_done != NULL, RET_BAD_PARAMS);
+  if (polygon_worker_start(worker) != RET_OK) {
+    return RET_NOT_IMPL;
+  }
+
+  job->canceled = FALSE;
+  tk_mutex_lock(worker->lock);
+  polygon_worker_append(&worker->queue, &worker->queue_tail, job);
+  worker->unfinished++;
+  tk_cond_signal(worker->has_job);
+  tk_mutex_unlock(worker->lock);
+
+  worker->pending++;
+  if (worker->timer_id == TK_INVALID_ID) {
+    worker->timer_id =
+        timer_add(polygon_worker_on_timer, worker, POLYGON_WORKER_DISPATCH_INTERVAL);
+  }
+
+  return RET_OK;
+}
+
+ret_t polygon_worker_cancel(polygon_job_t* job) {
+  polygon_worker_impl_t* worker = &s_polygon_worker;
+  return_value_if_fail(job != NULL, RET_BAD_PARAMS);
+
+  if (worker->lock != NULL) {
+    tk_mutex_lock(worker->lock);
+    job->canceled = TRUE;
+    tk_mutex_unlock(worker->lock);
+  } else {
+    job->canceled = TRUE;
+  }
+
+  return RET_OK;
+}
+
+uint32_t polygon_worker_dispatch(void) {
+  uint32_t n = 0;
+  polygon_job_t* iter = NULL;
+  polygon_job_t* next = NULL;
+  polygon_worker_impl_t* worker = &s_polygon_worker;
+
+  if (worker->lock == NULL) {
+    return 0;
+  }
+
+  tk_mutex_lock(worker->lock);
+  iter = worker->done;
+  worker->done = NULL;
+  worker->done_tail = NULL;
+  tk_mutex_unlock(worker->lock);
+
+  while (iter != NULL) {
+    next = iter->next;
+    iter->next = NULL;
+    worker->pending--;
+    iter->on_done(iter);
+    iter = next;
+    n++;
+  }
+
+  return n;
+}
+
+ret_t polygon_worker_flush(void) {
+  polygon_worker_impl_t* worker = &s_polygon_worker;
+
+  if (worker->lock == NULL) {
+    return RET_OK;
+  }
+
+  tk_mutex_lock(worker->lock);
+  while (worker->unfinished > 0) {
+    tk_cond_wait(worker->all_done, worker->lock);
+  }
+  tk_mutex_unlock(worker->lock);
+
+  polygon_worker_dispatch();
+
+  return RET_OK;
+}
+
+uint32_t polygon_worker_get_pending(void) {
+  return s_polygon_worker.pending;
+}
+
+ret_t polygon_worker_deinit(void) {
+  uint32_t i = 0;
+  polygon_worker_impl_t* worker = &s_polygon_worker;
+
+  if (worker->thread_nr > 0) {
+    polygon_worker_flush();
+
+    tk_mutex_lock(worker->lock);
+    worker->quit = TRUE;
+    tk_cond_broadcast(worker->has_job);
+    tk_mutex_unlock(worker->lock);
+
+    for (i = 0; i < worker->thread_nr; i++) {
+      tk_thread_join(worker->threads[i]);
+      tk_thread_destroy(worker->threads[i]);
+    }
+  }
+
+  if (worker->timer_id != TK_INVALID_ID) {
+    timer_remove(worker->timer_id);
+  }
+  if (worker->all_done != NULL) {
+    tk_cond_destroy(worker->all_done);
+  }
+  if (worker->has_job != NULL) {
+    tk_cond_destroy(worker->has_job);
+  }
+  if (worker->lock != NULL) {
+    tk_mutex_destroy(worker->lock);
+  }
+
+  memset(worker, 0x00, sizeof(polygon_worker_impl_t));
+
+  return RET_OK;
+}
@@ -0,0 +1,142 @@
+﻿/**
+ * File:   polygon_worker.h
+ * Author: AWTK Develop Team
+ * Brief:  在后台线程中准备几何数据的任务池。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#ifndef TK_POLYGON_WORKER_H
+#define TK_POLYGON_WORKER_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+#ifndef POLYGON_WORKER_THREAD_NR
+#define POLYGON_WORKER_THREAD_NR 2
+#endif /*POLYGON_WORKER_THREAD_NR*/
+
+struct _polygon_job_t;
+typedef struct _polygon_job_t polygon_job_t;
+
+typedef ret_t (*polygon_job_run_t)(polygon_job_t* job);
+typedef ret_t (*polygon_job_done_t)(polygon_job_t* job);
+
+/**
+ * @class polygon_job_t
+ * 后台任务。
+ *
+ * run 在后台线程中执行，只能访问任务自己的数据(提交时准备好的快照和计算结果)。
+ * on_done 在 GUI 线程中执行，负责把结果交给控件并释放任务。
+ * 两者不会同时访问控件，所以结果的替换不需要加锁。
+ */
+struct _polygon_job_t {
+  /**
+   * @property {polygon_job_run_t} run
+   * 在后台线程中执行的函数。
+   */
+  polygon_job_run_t run;
+  /**
+   * @property {polygon_job_done_t} on_done
+   * 完成后在 GUI 线程中执行的函数(任务被取消时也会调用，以便释放任务)。
+   */
+  polygon_job_done_t on_done;
+  /**
+   * @property {bool_t} canceled
+   * 是否已经取消(由 polygon\_worker\_cancel 设置，在后台线程开始执行之前检查)。
+   */
+  bool_t canceled;
+
+  /*private*/
+  polygon_job_t* next;
+};
+
+/**
+ * @class polygon_worker_t
+ * @annotation ["fake"]
+ * 后台任务池。
+ *
+ * 第一次提交任务时创建 POLYGON_WORKER_THREAD_NR 个线程。完成的任务由 GUI 线程中的定时器分发，
+ * 也可以调用 polygon\_worker\_dispatch 主动分发。
+ *
+ * 一个线程也创建不了时(如平台不支持线程)会记住失败，以后提交任务直接返回 RET\_NOT\_IMPL，
+ * 不再重复尝试，调用 polygon\_worker\_deinit 后才会重新尝试。
+ */
+
+/**
+ * @method polygon_worker_submit
+ * 提交任务(只能在 GUI 线程中调用)。
+ * @annotation ["static"]
+ * @param {polygon_job_t*} job 任务。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，无法创建后台线程时返回RET_NOT_IMPL，否则表示失败
+ * (失败时任务不会被执行，由调用者释放)。
+ */
+ret_t polygon_worker_submit(polygon_job_t* job);
+
+/**
+ * @method polygon_worker_cancel
+ * 取消任务(只能在 GUI 线程中调用)。
+ *
+ * 还没有开始执行的任务不会再执行，正在执行的任务会执行完。两种情况下 on\_done 都会被调用。
+ * @annotation ["static"]
+ * @param {polygon_job_t*} job 任务。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_worker_cancel(polygon_job_t* job);
+
+/**
+ * @method polygon_worker_dispatch
+ * 在 GUI 线程中分发已经完成的任务。
+ * @annotation ["static"]
+ *
+ * @return {uint32_t} 返回分发的任务数。
+ */
+uint32_t polygon_worker_dispatch(void);
+
+/**
+ * @method polygon_worker_flush
+ * 等待所有已提交的任务完成，然后分发(只能在 GUI 线程中调用)。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_worker_flush(void);
+
+/**
+ * @method polygon_worker_get_pending
+ * 获取已提交但还没有分发的任务数。
+ * @annotation ["static"]
+ *
+ * @return {uint32_t} 返回任务数。
+ */
+uint32_t polygon_worker_get_pending(void);
+
+/**
+ * @method polygon_worker_deinit
+ * 完成全部任务并停止后台线程。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t polygon_worker_deinit(void);
+
+END_C_DECLS
+
+#endif /*TK_POLYGON_WORKER_H*/
@@ -21,115 +21,936 @@
 
 #include "tkc/mem.h"
 #include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "base/idle.h"
+#include "base/timer.h"
 #include "progress_polygon.h"
+#include "polygon_path.h"
+
+#define PROGRESS_POLYGON_PREWARM_BUDGET 4
+#define PROGRESS_POLYGON_FRAME_INTERVAL 16
+#define PROGRESS_POLYGON_COARSE_SIZE 32
+
+/*点数不少于这个值时，在后台线程中准备几何数据*/
+#ifndef PROGRESS_POLYGON_ASYNC_MIN_SIZE
+#define PROGRESS_POLYGON_ASYNC_MIN_SIZE 256
+#endif /*PROGRESS_POLYGON_ASYNC_MIN_SIZE*/
+
+typedef struct _progress_polygon_job_t {
+  polygon_job_t job;
+  widget_t* widget;
+  wh_t w;
+  wh_t h;
+  bool_t with_hit_grid;
+  ret_t ret;
+
+  /*提交时的快照，后台线程只读*/
+  polygon_stations_t stations;
+
+  /*计算结果，完成后在 GUI 线程中整体替换到控件中*/
+  polygon_geometry_t geometry;
+  polygon_hit_grid_t hit_grid;
+} progress_polygon_job_t;
+
+static ret_t progress_polygon_anim_stop(widget_t* widget) {
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  if (progress_polygon->anim != NULL) {
+    if (progress_polygon->anim->timer_id != TK_INVALID_ID) {
+      timer_remove(progress_polygon->anim->timer_id);
+    }
+    TKMEM_FREE(progress_polygon->anim);
+  }
+
+  return RET_OK;
+}
+
+static ret_t progress_polygon_invalidate_band(widget_t* widget, double from_value,
+                                              double to_value);
+
+ret_t progress_polygon_set_value(widget_t* widget, double value) {
+  double old_value = 0;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  progress_polygon_anim_stop(widget);
+  old_value = progress_polygon->value;
+  progress_polygon->value = value;
+  if (old_value != value) {
+    progress_polygon_invalidate_band(widget, old_value, value);
+  }
+
+  return RET_OK;
+}
+
+ret_t progress_polygon_set_start_value(widget_t* widget, double start_value) {
+  double old_value = 0;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  old_value = progress_polygon->start_value;
+  progress_polygon->start_value = start_value;
+  if (old_value != start_value) {
+    progress_polygon_invalidate_band(widget, old_value, start_value);
+  }
+
+  return RET_OK;
+}
+
+ret_t progress_polygon_set_min(widget_t* widget, double min) {
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  progress_polygon->min = min;
+
+  return RET_OK;
+}
+
+ret_t progress_polygon_set_max(widget_t* widget, double max) {
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  progress_polygon->max = max;
+
+  return RET_OK;
+}
+
+static ret_t progress_polygon_morph_stop(widget_t* widget) {
+  progress_polygon_morphing_t* morphing = NULL;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  morphing = progress_polygon->morphing;
+  if (morphing != NULL) {
+    if (morphing->timer_id != TK_INVALID_ID) {
+      timer_remove(morphing->timer_id);
+    }
+    polygon_morph_deinit(&morphing->morph);
+    TKMEM_FREE(morphing->target);
+    TKMEM_FREE(progress_polygon->morphing);
+  }
+
+  return RET_OK;
+}
 
+static ret_t progress_polygon_resolve(widget_t* widget, bool_t async);
 
+static ret_t progress_polygon_morph_finish(widget_t* widget) {
+  char* target = NULL;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL && progress_polygon->morphing != NULL,
+                       RET_BAD_PARAMS);
+
+  target = progress_polygon->morphing->target;
+  progress_polygon->morphing->target = NULL;
+  progress_polygon_morph_stop(widget);
+
+  /*目标形状成为新的多边形描述。立即计算准确的几何数据，不走异步的路径，
+   *否则点数很多时会先显示简化的形状，任务完成后再跳回来*/
+  TKMEM_FREE(progress_polygon->polygon);
+  progress_polygon->polygon = target;
+  progress_polygon->stations_dirty = FALSE;
+  polygon_stations_deinit(&progress_polygon->stations);
+  if (progress_polygon_resolve(widget, FALSE) != RET_OK) {
+    progress_polygon->stations_dirty = TRUE;
+  }
+  widget_invalidate(widget, NULL);
+
+  return RET_OK;
+}
+
+ret_t progress_polygon_set_polygon(widget_t* widget, const char* polygon) {
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  progress_polygon_morph_stop(widget);
+
+  /*只保存描述，解析和几何数据的计算推迟到第一次绘制或预热时进行*/
+  progress_polygon->polygon = tk_str_copy(progress_polygon->polygon, polygon);
+  progress_polygon->stations_dirty = TRUE;
+
+  return RET_OK;
+}
+
+ret_t progress_polygon_set_keep_polygon(widget_t* widget, bool_t keep_polygon) {
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  progress_polygon->keep_polygon = keep_polygon;
+  if (!keep_polygon && !progress_polygon->stations_dirty && progress_polygon->polygon != NULL) {
+    /*已经解析过的点数据可能已经释放，释放字符串之前重新解析*/
+    if (progress_polygon->stations.size == 0) {
+      polygon_stations_init(&progress_polygon->stations, progress_polygon->polygon);
+    }
+    if (progress_polygon->stations.size > 0) {
+      TKMEM_FREE(progress_polygon->polygon);
+    }
+  }
+
+  return RET_OK;
+}
+
+static const char* progress_polygon_get_polygon(widget_t* widget) {
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, NULL);
+
+  if (progress_polygon->polygon == NULL && progress_polygon->stations.size > 0) {
+    /*解析后已经释放，需要时再根据解析的结果重新生成，下次 prepare 时释放*/
+    str_t str;
+    str_init(&str, progress_polygon->stations.size * 32);
+    polygon_stations_to_str(&progress_polygon->stations, &str);
+    progress_polygon->polygon = str.str;
+  }
+
+  return progress_polygon->polygon;
+}
+
+static ret_t progress_polygon_reset_fg_gradient(widget_t* widget) {
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  if (progress_polygon->fg_gradient != NULL) {
+    polygon_gradient_deinit(progress_polygon->fg_gradient);
+    TKMEM_FREE(progress_polygon->fg_gradient);
+  }
+  TKMEM_FREE(progress_polygon->fg_gradient_spec);
+
+  return RET_OK;
+}
+
+static polygon_gradient_t* progress_polygon_get_fg_gradient(widget_t* widget, const char* spec) {
+  polygon_gradient_t* gradient = NULL;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, NULL);
+
+  if (spec == NULL || *spec == '\0') {
+    progress_polygon_reset_fg_gradient(widget);
+    return NULL;
+  }
+
+  if (progress_polygon->fg_gradient == NULL ||
+      !tk_str_eq(progress_polygon->fg_gradient_spec, spec)) {
+    progress_polygon_reset_fg_gradient(widget);
+    progress_polygon->fg_gradient = TKMEM_ZALLOC(polygon_gradient_t);
+    return_value_if_fail(progress_polygon->fg_gradient != NULL, NULL);
+    progress_polygon->fg_gradient_spec = tk_strdup(spec);
+    polygon_gradient_init(progress_polygon->fg_gradient, spec);
+  }
+
+  gradient = progress_polygon->fg_gradient;
+  if (gradient->nr == 0) {
+    return NULL;
+  }
+
+  /*条带和几何数据一起缓存，只有几何数据变化时才重新计算*/
+  if (!polygon_gradient_has_strips(gradient)) {
+    return_value_if_fail(
+        polygon_gradient_build_strips(gradient, &progress_polygon->geometry) == RET_OK, NULL);
+  }
 
-static uint32_t polygon_points_find(polygon_points_t* points, double value) {
+  return gradient;
+}
+
+static ret_t progress_polygon_reset_hit_grid(widget_t* widget) {
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  if (progress_polygon->hit_grid != NULL) {
+    polygon_hit_grid_deinit(progress_polygon->hit_grid);
+    TKMEM_FREE(progress_polygon->hit_grid);
+  }
+
+  return RET_OK;
+}
+
+static ret_t progress_polygon_on_geometry_changed(widget_t* widget) {
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  progress_polygon_reset_hit_grid(widget);
+  if (progress_polygon->fg_gradient != NULL) {
+    polygon_gradient_reset_strips(progress_polygon->fg_gradient);
+  }
+
+  return RET_OK;
+}
+
+uint32_t progress_polygon_get_mem_size(widget_t* widget) {
+  uint32_t size = 0;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, 0);
+
+  size = sizeof(progress_polygon_t) - sizeof(widget_t);
+  if (progress_polygon->polygon != NULL) {
+    size += strlen(progress_polygon->polygon) + 1;
+  }
+  size += polygon_stations_get_mem_size(&progress_polygon->stations);
+  size += polygon_geometry_get_mem_size(&progress_polygon->geometry);
+  if (progress_polygon->hit_grid != NULL) {
+    size += sizeof(polygon_hit_grid_t) + polygon_hit_grid_get_mem_size(progress_polygon->hit_grid);
+  }
+  if (progress_polygon->morphing != NULL) {
+    size += sizeof(progress_polygon_morphing_t) + strlen(progress_polygon->morphing->target) + 1;
+    size += polygon_morph_get_mem_size(&progress_polygon->morphing->morph);
+  }
+  if (progress_polygon->anim != NULL) {
+    size += sizeof(progress_polygon_anim_t);
+  }
+  if (progress_polygon->fg_gradient != NULL) {
+    size += sizeof(polygon_gradient_t) + strlen(progress_polygon->fg_gradient_spec) + 1;
+    size += polygon_geometry_get_mem_size(&progress_polygon->fg_gradient->strips);
+    size += progress_polygon->fg_gradient->strips.size * sizeof(color_t);
+  }
+
+  return size;
+}
+
+ret_t progress_polygon_set_morph_duration(widget_t* widget, uint32_t morph_duration) {
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  progress_polygon->morph_duration = morph_duration;
+
+  return RET_OK;
+}
+
+typedef struct _progress_polygon_easing_t {
+  const char* name;
+  easing_type_t type;
+} progress_polygon_easing_t;
+
+static const progress_polygon_easing_t s_progress_polygon_easings[] = {
+    {"linear", EASING_LINEAR},
+    {"quadratic_in", EASING_QUADRATIC_IN},
+    {"quadratic_out", EASING_QUADRATIC_OUT},
+    {"quadratic_inout", EASING_QUADRATIC_INOUT},
+    {"cubic_in", EASING_CUBIC_IN},
+    {"cubic_out", EASING_CUBIC_OUT},
+    {"sin_in", EASING_SIN_IN},
+    {"sin_out", EASING_SIN_OUT},
+    {"sin_inout", EASING_SIN_INOUT},
+    {"pow_in", EASING_POW_IN},
+    {"pow_out", EASING_POW_OUT},
+    {"pow_inout", EASING_POW_INOUT},
+    {"circular_in", EASING_CIRCULAR_IN},
+    {"circular_out", EASING_CIRCULAR_OUT},
+    {"circular_inout", EASING_CIRCULAR_INOUT},
+    {"elastic_in", EASING_ELASTIC_IN},
+    {"elastic_out", EASING_ELASTIC_OUT},
+    {"elastic_inout", EASING_ELASTIC_INOUT},
+    {"back_in", EASING_BACK_IN},
+    {"back_out", EASING_BACK_OUT},
+    {"back_inout", EASING_BACK_INOUT},
+    {"bounce_in", EASING_BOUNCE_IN},
+    {"bounce_out", EASING_BOUNCE_OUT},
+    {"bounce_inout", EASING_BOUNCE_INOUT},
+};
+
+static easing_type_t progress_polygon_easing_find(const char* name) {
   uint32_t i = 0;
-  polygon_point_t* iter = NULL;
-  return_value_if_fail(points != NULL, 0);
 
-  for (i = 0; i < points->size; i++) {
-    iter = points->points + i;
-    if (iter->value >= value) {
-      return i;
+  for (i = 0; i < ARRAY_SIZE(s_progress_polygon_easings); i++) {
+    if (tk_str_eq(s_progress_polygon_easings[i].name, name)) {
+      return s_progress_polygon_easings[i].type;
     }
   }
 
-  return points->size;
+  return EASING_LINEAR;
 }
 
-ret_t polygon_points_init(polygon_points_t* arr, const char* data) {
-  const char* p = data;
-  polygon_point_t* iter = NULL;
-  uint32_t n = tk_count_char(data, '(');
-  return_value_if_fail(arr != NULL && data != NULL, RET_BAD_PARAMS);
+static char* progress_polygon_trim(char* str) {
+  char* end = NULL;
 
-  arr->size = 0;
-  arr->capacity = n;
-  arr->points = TKMEM_ZALLOCN(polygon_point_t, n);
-  return_value_if_fail(arr->points != NULL, RET_OOM);
+  str = (char*)tk_skip_chars(str, " \t\r\n");
+  end = str + strlen(str);
+  while (end > str && strchr(" \t\r\n", end[-1]) != NULL) {
+    *--end = '\0';
+  }
 
-  do {
-    p = tk_skip_to_chars(p, "(");
-    if (p == NULL || *p == '\0') break;
+  return str;
+}
 
-    iter = arr->points + arr->size++;
-    p = tk_skip_chars(p, " ");
-    iter->value = tk_atof(p + 1);
+ret_t progress_polygon_set_value_animation(widget_t* widget, const char* value_animation) {
+  char item[64];
+  const char* p = value_animation;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
 
-    p = tk_skip_to_chars(p, ",");
-    break_if_fail(*p == ',');
-    p = tk_skip_chars(p, " ");
-    iter->x1 = tk_atof(p + 1);
+  progress_polygon->value_animation =
+      tk_str_copy(progress_polygon->value_animation, value_animation);
+  progress_polygon->anim_cfg_duration = 0;
+  progress_polygon->anim_cfg_easing = EASING_LINEAR;
+
+  /*格式如："duration=500,easing=sin_inout"*/
+  while (p != NULL && *p) {
+    char* value = NULL;
+    const char* end = tk_skip_to_chars(p, ",;");
+    uint32_t len = tk_min((uint32_t)(end - p), sizeof(item) - 1);
+
+    memcpy(item, p, len);
+    item[len] = '\0';
+    value = strchr(item, '=');
+    if (value != NULL) {
+      const char* name = NULL;
+
+      *value++ = '\0';
+      name = progress_polygon_trim(item);
+      value = progress_polygon_trim(value);
+      if (tk_str_eq(name, "duration")) {
+        progress_polygon->anim_cfg_duration = tk_atoi(value);
+      } else if (tk_str_eq(name, "easing")) {
+        progress_polygon->anim_cfg_easing = progress_polygon_easing_find(value);
+      }
+    }
 
-    p = tk_skip_to_chars(p + 1, ",");
-    break_if_fail(*p == ',');
-    p = tk_skip_chars(p, " ");
-    iter->y1 = tk_atof(p + 1);
+    p = *end ? end + 1 : end;
+  }
 
-    p = tk_skip_to_chars(p + 1, ",");
-    break_if_fail(*p == ',');
-    p = tk_skip_chars(p, " ");
-    iter->x2 = tk_atof(p + 1);
+  return RET_OK;
+}
 
-    p = tk_skip_to_chars(p + 1, ",");
-    break_if_fail(*p == ',');
-    p = tk_skip_chars(p, " ");
-    iter->y2 = tk_atof(p + 1);
+ret_t progress_polygon_set_editable(widget_t* widget, bool_t editable) {
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
 
-    p = tk_skip_to_chars(p + 1, ")");
-    break_if_fail(*p == ')');
-    assert(arr->size <= arr->capacity);
-  } while (TRUE);
+  progress_polygon->editable = editable;
 
   return RET_OK;
 }
 
-ret_t polygon_points_deinit(polygon_points_t* points) {
-  return_value_if_fail(points != NULL, RET_BAD_PARAMS);
+static ret_t progress_polygon_job_run(polygon_job_t* job) {
+  progress_polygon_job_t* prepare = (progress_polygon_job_t*)job;
 
-  TKMEM_FREE(points->points);
-  memset(points, 0x00, sizeof(polygon_points_t));
+  prepare->ret = polygon_geometry_resolve(&prepare->geometry, &prepare->stations, prepare->w,
+                                          prepare->h);
+  if (prepare->ret == RET_OK && prepare->with_hit_grid) {
+    polygon_hit_grid_build(&prepare->hit_grid, &prepare->geometry);
+  }
+
+  return prepare->ret;
+}
+
+static ret_t progress_polygon_job_destroy(progress_polygon_job_t* prepare) {
+  polygon_hit_grid_deinit(&prepare->hit_grid);
+  polygon_geometry_deinit(&prepare->geometry);
+  polygon_stations_deinit(&prepare->stations);
+  TKMEM_FREE(prepare);
 
   return RET_OK;
 }
 
-ret_t progress_polygon_set_value(widget_t* widget, double value) {
+static ret_t progress_polygon_job_on_done(polygon_job_t* job) {
+  progress_polygon_job_t* prepare = (progress_polygon_job_t*)job;
+
+  /*在 GUI 线程中执行，和绘制不会同时进行，直接交换即可*/
+  if (!job->canceled) {
+    widget_t* widget = prepare->widget;
+    progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+
+    progress_polygon->prepare_job = NULL;
+    if (prepare->ret == RET_OK) {
+      polygon_geometry_t geometry;
+
+      progress_polygon_on_geometry_changed(widget);
+      geometry = progress_polygon->geometry;
+      progress_polygon->geometry = prepare->geometry;
+      prepare->geometry = geometry;
+      if (!polygon_hit_grid_is_empty(&prepare->hit_grid)) {
+        progress_polygon->hit_grid = TKMEM_ZALLOC(polygon_hit_grid_t);
+        if (progress_polygon->hit_grid != NULL) {
+          *(progress_polygon->hit_grid) = prepare->hit_grid;
+          polygon_hit_grid_init(&prepare->hit_grid);
+        }
+      }
+      widget_invalidate(widget, NULL);
+    }
+  }
+
+  return progress_polygon_job_destroy(prepare);
+}
+
+static ret_t progress_polygon_cancel_job(widget_t* widget) {
   progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
   return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
 
-  progress_polygon->value = value;
+  /*任务由任务池释放*/
+  if (progress_polygon->prepare_job != NULL) {
+    polygon_worker_cancel(progress_polygon->prepare_job);
+    progress_polygon->prepare_job = NULL;
+  }
 
   return RET_OK;
 }
 
-ret_t progress_polygon_set_min(widget_t* widget, double min) {
+static ret_t progress_polygon_submit_job(widget_t* widget) {
+  progress_polygon_job_t* prepare = NULL;
   progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
   return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
 
-  progress_polygon->min = min;
+  prepare = TKMEM_ZALLOC(progress_polygon_job_t);
+  return_value_if_fail(prepare != NULL, RET_OOM);
+
+  prepare->job.run = progress_polygon_job_run;
+  prepare->job.on_done = progress_polygon_job_on_done;
+  prepare->widget = widget;
+  prepare->w = widget->w;
+  prepare->h = widget->h;
+  prepare->with_hit_grid = progress_polygon->editable;
+  polygon_geometry_init(&prepare->geometry);
+  polygon_hit_grid_init(&prepare->hit_grid);
+
+  /*能从 polygon 字符串重新解析时，点数据直接交给任务，不再复制*/
+  if (progress_polygon->polygon != NULL) {
+    prepare->stations = progress_polygon->stations;
+    memset(&progress_polygon->stations, 0x00, sizeof(polygon_stations_t));
+  } else if (polygon_stations_copy(&prepare->stations, &progress_polygon->stations) != RET_OK) {
+    progress_polygon_job_destroy(prepare);
+    return RET_FAIL;
+  }
+
+  if (polygon_worker_submit(&prepare->job) != RET_OK) {
+    if (progress_polygon->polygon != NULL) {
+      progress_polygon->stations = prepare->stations;
+      memset(&prepare->stations, 0x00, sizeof(polygon_stations_t));
+    }
+    progress_polygon_job_destroy(prepare);
+    return RET_FAIL;
+  }
+  progress_polygon->prepare_job = &prepare->job;
 
   return RET_OK;
 }
 
-ret_t progress_polygon_set_max(widget_t* widget, double max) {
+static ret_t progress_polygon_load_stations(widget_t* widget) {
   progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
   return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
 
-  progress_polygon->max = max;
+  if (progress_polygon->stations.size > 0) {
+    return RET_OK;
+  }
+
+  if (progress_polygon->polygon == NULL) {
+    return RET_FAIL;
+  }
+
+  polygon_stations_init(&progress_polygon->stations, progress_polygon->polygon);
+  if (progress_polygon->stations.size == 0) {
+    return RET_FAIL;
+  }
+
+  if (!progress_polygon->keep_polygon) {
+    TKMEM_FREE(progress_polygon->polygon);
+  }
 
   return RET_OK;
 }
 
-ret_t progress_polygon_set_polygon(widget_t* widget, const char* polygon) {
+static ret_t progress_polygon_drop_stations(widget_t* widget) {
   progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
   return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
 
-  progress_polygon->polygon = tk_str_copy(progress_polygon->polygon, polygon);
-  polygon_points_deinit(&progress_polygon->points);
-  polygon_points_init(&progress_polygon->points, polygon);
+  /*保留了 polygon 字符串时，大小变化后可以重新解析，不需要一直保存点数据*/
+  if (progress_polygon->polygon != NULL) {
+    polygon_stations_deinit(&progress_polygon->stations);
+  }
+
+  return RET_OK;
+}
+
+static ret_t progress_polygon_resolve(widget_t* widget, bool_t async) {
+  ret_t ret = RET_OK;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  progress_polygon_cancel_job(widget);
+  progress_polygon_on_geometry_changed(widget);
+  if (progress_polygon_load_stations(widget) != RET_OK) {
+    return RET_FAIL;
+  }
+
+  if (async && progress_polygon->stations.size >= PROGRESS_POLYGON_ASYNC_MIN_SIZE) {
+    /*精确的几何数据在后台准备，完成之前先用简化的形状绘制*/
+    ret = polygon_geometry_resolve_coarse(&progress_polygon->geometry, &progress_polygon->stations,
+                                          widget->w, widget->h, PROGRESS_POLYGON_COARSE_SIZE);
+    if (ret == RET_OK && progress_polygon_submit_job(widget) == RET_OK) {
+      return RET_OK;
+    }
+  }
+
+  ret = polygon_geometry_resolve(&progress_polygon->geometry, &progress_polygon->stations,
+                                 widget->w, widget->h);
+  progress_polygon_drop_stations(widget);
+
+  return ret;
+}
+
+static bool_t progress_polygon_is_prepared(widget_t* widget) {
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, FALSE);
+
+  return !progress_polygon->stations_dirty &&
+         polygon_geometry_is_valid_for(&progress_polygon->geometry, widget->w, widget->h);
+}
+
+static ret_t progress_polygon_prepare(widget_t* widget) {
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  if (progress_polygon->morphing != NULL &&
+      !polygon_geometry_is_valid_for(&progress_polygon->geometry, widget->w, widget->h)) {
+    /*变形过程中控件大小发生了变化，直接跳到目标形状*/
+    progress_polygon_morph_finish(widget);
+  }
+
+  if (!progress_polygon->keep_polygon && !progress_polygon->stations_dirty &&
+      progress_polygon->polygon != NULL && progress_polygon->stations.size > 0) {
+    /*get_prop 临时生成的字符串，不长期保存*/
+    TKMEM_FREE(progress_polygon->polygon);
+  }
+
+  if (progress_polygon->stations_dirty) {
+    progress_polygon->stations_dirty = FALSE;
+    progress_polygon_cancel_job(widget);
+    progress_polygon_on_geometry_changed(widget);
+    polygon_stations_deinit(&progress_polygon->stations);
+    polygon_geometry_deinit(&progress_polygon->geometry);
+  }
+
+  if (!polygon_geometry_is_valid_for(&progress_polygon->geometry, widget->w, widget->h)) {
+    return progress_polygon_resolve(widget, TRUE);
+  }
+
+  return RET_OK;
+}
+
+ret_t progress_polygon_prewarm(widget_t* widget) {
+  return_value_if_fail(PROGRESS_POLYGON(widget) != NULL, RET_BAD_PARAMS);
+
+  return progress_polygon_prepare(widget);
+}
+
+static ret_t progress_polygon_on_morph_step(widget_t* widget) {
+  polygon_gradient_t* gradient = NULL;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  /*渐变色的条带在原来的内存中更新。点击测试的网格索引变形结束后才重新建立，变形过程中继续使用*/
+  gradient = progress_polygon->fg_gradient;
+  if (gradient != NULL && polygon_gradient_has_strips(gradient)) {
+    return polygon_gradient_update_strips(gradient, &progress_polygon->geometry);
+  }
+
+  return RET_OK;
+}
+
+static ret_t progress_polygon_on_morph_timer(const timer_info_t* info) {
+  float t = 1;
+  uint64_t elapsed = 0;
+  progress_polygon_morphing_t* morphing = NULL;
+  widget_t* widget = WIDGET(info->ctx);
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_REMOVE);
+
+  morphing = progress_polygon->morphing;
+  return_value_if_fail(morphing != NULL, RET_REMOVE);
+
+  elapsed = time_now_ms() - morphing->start;
+  if (morphing->time > 0) {
+    t = (float)elapsed / morphing->time;
+  }
+
+  if (t >= 1) {
+    morphing->timer_id = TK_INVALID_ID;
+    progress_polygon_morph_finish(widget);
+    return RET_REMOVE;
+  }
+
+  /*点数在变形开始时已经确定，每一帧只更新坐标，不重新分配内存*/
+  polygon_morph_step(&morphing->morph, t, &progress_polygon->geometry);
+  progress_polygon_on_morph_step(widget);
+  widget_invalidate(widget, NULL);
+
+  return RET_REPEAT;
+}
+
+ret_t progress_polygon_morph_to(widget_t* widget, const char* polygon, uint32_t duration) {
+  ret_t ret = RET_FAIL;
+  polygon_stations_t stations;
+  polygon_geometry_t target;
+  progress_polygon_morphing_t* morphing = NULL;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL && polygon != NULL, RET_BAD_PARAMS);
+
+  /*正在变形时从当前(中间)形状开始新的变形*/
+  progress_polygon_morph_stop(widget);
+  if (duration == 0 || progress_polygon_prepare(widget) != RET_OK) {
+    return progress_polygon_set_polygon(widget, polygon);
+  }
+
+  /*变形需要从准确的形状开始*/
+  if (progress_polygon->prepare_job != NULL) {
+    progress_polygon_resolve(widget, FALSE);
+  }
+
+  memset(&stations, 0x00, sizeof(stations));
+  if (polygon_stations_init(&stations, polygon) != RET_OK || stations.size == 0) {
+    /*无法解析的目标形状，保持当前形状不变*/
+    polygon_stations_deinit(&stations);
+    return RET_BAD_PARAMS;
+  }
+
+  polygon_geometry_init(&target);
+  morphing = TKMEM_ZALLOC(progress_polygon_morphing_t);
+  if (morphing != NULL &&
+      polygon_geometry_resolve(&target, &stations, widget->w, widget->h) == RET_OK) {
+    ret = polygon_morph_init(&morphing->morph, &progress_polygon->geometry, &target);
+  }
+  polygon_geometry_deinit(&target);
+  polygon_stations_deinit(&stations);
+
+  if (ret != RET_OK) {
+    TKMEM_FREE(morphing);
+    return progress_polygon_set_polygon(widget, polygon);
+  }
+
+  /*重新采样后点数可能变化，只在开始时分配一次*/
+  polygon_morph_step(&morphing->morph, 0, &progress_polygon->geometry);
+  progress_polygon_on_geometry_changed(widget);
+
+  morphing->target = tk_strdup(polygon);
+  morphing->time = duration;
+  morphing->start = time_now_ms();
+  morphing->timer_id =
+      widget_add_timer(widget, progress_polygon_on_morph_timer, PROGRESS_POLYGON_FRAME_INTERVAL);
+  progress_polygon->morphing = morphing;
+
+  return RET_OK;
+}
+
+static ret_t progress_polygon_prewarm_reset_visit(void* ctx, const void* data) {
+  widget_t* iter = WIDGET(data);
+
+  if (WIDGET_IS_INSTANCE_OF(iter, progress_polygon)) {
+    PROGRESS_POLYGON(iter)->prewarm_tried = FALSE;
+  }
+
+  return RET_OK;
+}
+
+static ret_t progress_polygon_prewarm_visit(void* ctx, const void* data) {
+  uint32_t* budget = (uint32_t*)ctx;
+  widget_t* iter = WIDGET(data);
+
+  /*每个控件只尝试一次，无法准备好的控件(如多边形为空、大小为 0)不会让 idle 一直重复*/
+  if (WIDGET_IS_INSTANCE_OF(iter, progress_polygon) && !PROGRESS_POLYGON(iter)->prewarm_tried) {
+    PROGRESS_POLYGON(iter)->prewarm_tried = TRUE;
+    if (!progress_polygon_is_prepared(iter)) {
+      progress_polygon_prepare(iter);
+      *budget = *budget - 1;
+    }
+  }
+
+  return *budget > 0 ? RET_OK : RET_STOP;
+}
+
+static ret_t progress_polygon_prewarm_on_idle(const idle_info_t* info) {
+  uint32_t budget = PROGRESS_POLYGON_PREWARM_BUDGET;
+  widget_t* root = WIDGET(info->ctx);
+
+  widget_foreach(root, progress_polygon_prewarm_visit, &budget);
+
+  /*每次只处理少量控件，没处理完就等下一次 idle 继续，全部尝试过一遍后删除 idle*/
+  return budget > 0 ? RET_REMOVE : RET_REPEAT;
+}
+
+ret_t progress_polygon_prewarm_all(widget_t* root) {
+  return_value_if_fail(root != NULL, RET_BAD_PARAMS);
+
+  widget_foreach(root, progress_polygon_prewarm_reset_visit, NULL);
+
+  return widget_add_idle(root, progress_polygon_prewarm_on_idle) != TK_INVALID_ID ? RET_OK
+                                                                                  : RET_FAIL;
+}
+
+static double progress_polygon_value_to_progress(progress_polygon_t* progress_polygon,
+                                                 double value) {
+  return_value_if_fail(progress_polygon->max > progress_polygon->min, 0);
+
+  value = tk_clamp(value, progress_polygon->min, progress_polygon->max);
+
+  return (value - progress_polygon->min) / (progress_polygon->max - progress_polygon->min);
+}
+
+static double progress_polygon_get_progress(progress_polygon_t* progress_polygon) {
+  return progress_polygon_value_to_progress(progress_polygon, progress_polygon->value);
+}
+
+static ret_t progress_polygon_invalidate_band(widget_t* widget, double from_value,
+                                              double to_value) {
+  rect_t r;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+
+  if (progress_polygon->geometry.size == 0 || progress_polygon->max <= progress_polygon->min) {
+    return widget_invalidate(widget, NULL);
+  }
+
+  /*只刷新边界扫过的区域*/
+  polygon_geometry_get_band(&progress_polygon->geometry,
+                            progress_polygon_value_to_progress(progress_polygon, from_value),
+                            progress_polygon_value_to_progress(progress_polygon, to_value), &r);
+
+  return widget_invalidate(widget, &r);
+}
+
+static bool_t progress_polygon_easing_is_monotonic(easing_type_t easing) {
+  switch (easing) {
+    case EASING_LINEAR:
+    case EASING_QUADRATIC_IN:
+    case EASING_QUADRATIC_OUT:
+    case EASING_QUADRATIC_INOUT:
+    case EASING_CUBIC_IN:
+    case EASING_CUBIC_OUT:
+    case EASING_SIN_IN:
+    case EASING_SIN_OUT:
+    case EASING_SIN_INOUT:
+    case EASING_POW_IN:
+    case EASING_POW_OUT:
+    case EASING_POW_INOUT:
+    case EASING_CIRCULAR_IN:
+    case EASING_CIRCULAR_OUT:
+    case EASING_CIRCULAR_INOUT:
+      return TRUE;
+    default:
+      return FALSE;
+  }
+}
+
+static bool_t progress_polygon_is_settled(widget_t* widget, double value, double target) {
+  uint32_t offset = 0;
+  polygon_point_t a;
+  polygon_point_t b;
+  float d = 0;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  const polygon_geometry_t* geo = &progress_polygon->geometry;
+
+  if (geo->size == 0) {
+    return FALSE;
+  }
+
+  polygon_geometry_get_boundary(geo, progress_polygon_value_to_progress(progress_polygon, value),
+                                &offset, &a);
+  polygon_geometry_get_boundary(geo, progress_polygon_value_to_progress(progress_polygon, target),
+                                &offset, &b);
+
+  d = tk_max(tk_abs(a.x1 - b.x1), tk_abs(a.y1 - b.y1));
+  d = tk_max(d, tk_max(tk_abs(a.x2 - b.x2), tk_abs(a.y2 - b.y2)));
+
+  return d < 1;
+}
+
+static ret_t progress_polygon_on_anim_timer(const timer_info_t* info) {
+  float t = 1;
+  double value = 0;
+  double old_value = 0;
+  bool_t done = FALSE;
+  uint64_t elapsed = 0;
+  progress_polygon_anim_t* anim = NULL;
+  widget_t* widget = WIDGET(info->ctx);
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL && progress_polygon->anim != NULL, RET_REMOVE);
+
+  anim = progress_polygon->anim;
+  elapsed = time_now_ms() - anim->start;
+  if (anim->duration > 0) {
+    t = tk_min((float)elapsed / anim->duration, 1);
+  }
+
+  /*直接由时间算出当前的值，不依赖上一帧*/
+  value = anim->from + (anim->to - anim->from) * easing_get(anim->easing)(t);
+
+  /*边界离目标不到 1 像素时，剩下的帧看不出变化，提前结束*/
+  if (t >= 1 || (progress_polygon_easing_is_monotonic(anim->easing) &&
+                 progress_polygon_is_settled(widget, value, anim->to))) {
+    value = anim->to;
+    done = TRUE;
+  }
+
+  old_value = progress_polygon->value;
+  progress_polygon->value = value;
+  progress_polygon_invalidate_band(widget, old_value, value);
+
+  if (done) {
+    anim->timer_id = TK_INVALID_ID;
+    TKMEM_FREE(progress_polygon->anim);
+    return RET_REMOVE;
+  }
+
+  return RET_REPEAT;
+}
+
+ret_t progress_polygon_animate_to(widget_t* widget, double value, uint32_t duration,
+                                  easing_type_t easing) {
+  double old_value = 0;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(easing < EASING_FUNC_NR, RET_BAD_PARAMS);
+
+  progress_polygon_anim_stop(widget);
+  old_value = progress_polygon->value;
+
+  /*不强制解析多边形，还没有几何数据时不做提前结束的判断*/
+  if (duration == 0 || (progress_polygon_is_prepared(widget) &&
+                        progress_polygon_is_settled(widget, old_value, value))) {
+    progress_polygon->value = value;
+    return progress_polygon_invalidate_band(widget, old_value, value);
+  }
+
+  progress_polygon->anim = TKMEM_ZALLOC(progress_polygon_anim_t);
+  return_value_if_fail(progress_polygon->anim != NULL, RET_OOM);
+
+  progress_polygon->anim->from = old_value;
+  progress_polygon->anim->to = value;
+  progress_polygon->anim->duration = duration;
+  progress_polygon->anim->easing = easing;
+  progress_polygon->anim->start = time_now_ms();
+  progress_polygon->anim->timer_id =
+      widget_add_timer(widget, progress_polygon_on_anim_timer, PROGRESS_POLYGON_FRAME_INTERVAL);
+
+  return RET_OK;
+}
+
+ret_t progress_polygon_get_value_at(widget_t* widget, xy_t x, xy_t y, double* value) {
+  float progress = 0;
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+  return_value_if_fail(progress_polygon != NULL && value != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(progress_polygon_prepare(widget) == RET_OK, RET_BAD_PARAMS);
+
+  if (progress_polygon->geometry.size < 2) {
+    return RET_NOT_FOUND;
+  }
+
+  /*网格索引只在需要点击测试时才创建*/
+  if (progress_polygon->hit_grid == NULL) {
+    polygon_hit_grid_t* grid = TKMEM_ZALLOC(polygon_hit_grid_t);
+    return_value_if_fail(grid != NULL, RET_OOM);
+
+    polygon_hit_grid_init(grid);
+    if (polygon_hit_grid_build(grid, &progress_polygon->geometry) != RET_OK) {
+      TKMEM_FREE(grid);
+      return RET_OOM;
+    }
+    progress_polygon->hit_grid = grid;
+  }
+
+  if (polygon_hit_grid_query(progress_polygon->hit_grid, &progress_polygon->geometry, x, y,
+                             progress_polygon_get_progress(progress_polygon),
+                             &progress) != RET_OK) {
+    return RET_NOT_FOUND;
+  }
+
+  *value = progress_polygon->min + (progress_polygon->max - progress_polygon->min) * progress;
 
   return RET_OK;
 }
@@ -141,6 +962,9 @@ static ret_t progress_polygon_get_prop(widget_t* widget, const char* name, value
   if (tk_str_eq(PROGRESS_POLYGON_PROP_VALUE, name)) {
     value_set_double(v, progress_polygon->value);
     return RET_OK;
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_START_VALUE, name)) {
+    value_set_double(v, progress_polygon->start_value);
+    return RET_OK;
   } else if (tk_str_eq(PROGRESS_POLYGON_PROP_MIN, name)) {
     value_set_double(v, progress_polygon->min);
     return RET_OK;
@@ -148,7 +972,27 @@ static ret_t progress_polygon_get_prop(widget_t* widget, const char* name, value
     value_set_double(v, progress_polygon->max);
     return RET_OK;
   } else if (tk_str_eq(PROGRESS_POLYGON_PROP_POLYGON, name)) {
-    value_set_str(v, progress_polygon->polygon);
+    value_set_str(v, progress_polygon_get_polygon(widget));
+    return RET_OK;
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_KEEP_POLYGON, name)) {
+    value_set_bool(v, progress_polygon->keep_polygon);
+    return RET_OK;
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_EDITABLE, name)) {
+    value_set_bool(v, progress_polygon->editable);
+    return RET_OK;
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_ANIMATE_TO, name)) {
+    progress_polygon_anim_t* anim = progress_polygon->anim;
+    value_set_double(v, anim != NULL ? anim->to : progress_polygon->value);
+    return RET_OK;
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_MORPH_TO, name)) {
+    progress_polygon_morphing_t* morphing = progress_polygon->morphing;
+    value_set_str(v, morphing != NULL ? morphing->target : NULL);
+    return RET_OK;
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_MORPH_DURATION, name)) {
+    value_set_uint32(v, progress_polygon->morph_duration);
+    return RET_OK;
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_VALUE_ANIMATION, name)) {
+    value_set_str(v, progress_polygon->value_animation);
     return RET_OK;
   }
 
@@ -159,17 +1003,30 @@ static ret_t progress_polygon_set_prop(widget_t* widget, const char* name, const
   return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
   if (tk_str_eq(PROGRESS_POLYGON_PROP_VALUE, name)) {
-    progress_polygon_set_value(widget, value_double(v));
-    return RET_OK;
+    return progress_polygon_set_value(widget, value_double(v));
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_ANIMATE_TO, name)) {
+    progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+    return progress_polygon_animate_to(widget, value_double(v), progress_polygon->anim_cfg_duration,
+                                       progress_polygon->anim_cfg_easing);
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_START_VALUE, name)) {
+    return progress_polygon_set_start_value(widget, value_double(v));
   } else if (tk_str_eq(PROGRESS_POLYGON_PROP_MIN, name)) {
-    progress_polygon_set_min(widget, value_double(v));
-    return RET_OK;
+    return progress_polygon_set_min(widget, value_double(v));
   } else if (tk_str_eq(PROGRESS_POLYGON_PROP_MAX, name)) {
-    progress_polygon_set_max(widget, value_double(v));
-    return RET_OK;
+    return progress_polygon_set_max(widget, value_double(v));
   } else if (tk_str_eq(PROGRESS_POLYGON_PROP_POLYGON, name)) {
-    progress_polygon_set_polygon(widget, value_str(v));
-    return RET_OK;
+    return progress_polygon_set_polygon(widget, value_str(v));
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_KEEP_POLYGON, name)) {
+    return progress_polygon_set_keep_polygon(widget, value_bool(v));
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_EDITABLE, name)) {
+    return progress_polygon_set_editable(widget, value_bool(v));
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_MORPH_TO, name)) {
+    uint32_t duration = PROGRESS_POLYGON(widget)->morph_duration;
+    return progress_polygon_morph_to(widget, value_str(v), duration);
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_MORPH_DURATION, name)) {
+    return progress_polygon_set_morph_duration(widget, value_uint32(v));
+  } else if (tk_str_eq(PROGRESS_POLYGON_PROP_VALUE_ANIMATION, name)) {
+    return progress_polygon_set_value_animation(widget, value_str(v));
   }
 
   return RET_NOT_FOUND;
@@ -179,62 +1036,25 @@ static ret_t progress_polygon_on_destroy(widget_t* widget) {
   progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
   return_value_if_fail(widget != NULL && progress_polygon != NULL, RET_BAD_PARAMS);
 
-  polygon_points_deinit(&progress_polygon->points);
+  progress_polygon_morph_stop(widget);
+  progress_polygon_anim_stop(widget);
+  progress_polygon_cancel_job(widget);
+  progress_polygon_reset_fg_gradient(widget);
+  progress_polygon_reset_hit_grid(widget);
+  polygon_geometry_deinit(&progress_polygon->geometry);
+  polygon_stations_deinit(&progress_polygon->stations);
   TKMEM_FREE(progress_polygon->polygon);
+  TKMEM_FREE(progress_polygon->value_animation);
 
   return RET_OK;
 }
 
-static pointf_t progress_polygon_normalize_point(widget_t* widget, float x, float y) {
-  pointf_t p = {0};
-  return_value_if_fail(widget != NULL, p);
-  p.x = x > 1 ? x : x * widget->w;
-  p.y = y > 1 ? y : y * widget->h;
-
-  return p;
-}
-
-static ret_t progress_polygon_move_to(widget_t* widget, vgcanvas_t* vg, float x, float y) {
-  pointf_t point = {0};
-  return_value_if_fail(widget != NULL && vg != NULL, RET_BAD_PARAMS);
-
-  point = progress_polygon_normalize_point(widget, x, y);
-  vgcanvas_move_to(vg, point.x, point.y);
-
-  return RET_OK;
-}
-
-static ret_t progress_polygon_line_to(widget_t* widget, vgcanvas_t* vg, float x, float y) {
-  pointf_t point = {0};
-  return_value_if_fail(widget != NULL && vg != NULL, RET_BAD_PARAMS);
-
-  point = progress_polygon_normalize_point(widget, x, y);
-  vgcanvas_line_to(vg, point.x, point.y);
-
-  return RET_OK;
-}
-
-static ret_t pogress_polygon_draw_border(widget_t* widget, vgcanvas_t* vg, color_t border_color,
-                                         uint32_t line_width) {
-  int32_t i = 0;
-  polygon_point_t* iter = NULL;
-  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
-  return_value_if_fail(widget != NULL && vg != NULL, RET_BAD_PARAMS);
+static ret_t progress_polygon_draw_border(vgcanvas_t* vg, const polygon_geometry_t* geo,
+                                          color_t border_color, uint32_t line_width) {
+  return_value_if_fail(vg != NULL && geo != NULL, RET_BAD_PARAMS);
 
   vgcanvas_begin_path(vg);
-  iter = progress_polygon->points.points;
-  progress_polygon_move_to(widget, vg, iter->x1, iter->y1);
-  for (i = 1; i < progress_polygon->points.size; i++) {
-    iter = progress_polygon->points.points + i;
-    progress_polygon_line_to(widget, vg, iter->x1, iter->y1);
-  }
-
-  for (i = progress_polygon->points.size - 1; i >= 0; i--) {
-    iter = progress_polygon->points.points + i;
-    progress_polygon_line_to(widget, vg, iter->x2, iter->y2);
-  }
-
-  vgcanvas_close_path(vg);
+  polygon_path_add_outline(vg, geo, 0, 0);
   vgcanvas_set_line_width(vg, line_width);
   vgcanvas_set_stroke_color(vg, border_color);
   vgcanvas_stroke(vg);
@@ -244,7 +1064,6 @@ static ret_t pogress_polygon_draw_border(widget_t* widget, vgcanvas_t* vg, color
 
 static ret_t progress_polygon_fill(widget_t* widget, vgcanvas_t* vg, color_t color,
                                    const char* image) {
-  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
   return_value_if_fail(widget != NULL && vg != NULL, RET_BAD_PARAMS);
 
   if (image != NULL) {
@@ -263,81 +1082,123 @@ static ret_t progress_polygon_fill(widget_t* widget, vgcanvas_t* vg, color_t col
   return RET_OK;
 }
 
-static ret_t progress_polygon_draw_fg(widget_t* widget, vgcanvas_t* vg, color_t fg_color,
-                                      const char* fg_image, int32_t offset,
-                                      const polygon_point_t* end) {
-  int32_t i = 0;
-  int32_t n = 0;
-  bool_t include_end = FALSE;
-  polygon_point_t* iter = NULL;
-  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
-  return_value_if_fail(widget != NULL && vg != NULL && end != NULL, RET_BAD_PARAMS);
+static ret_t progress_polygon_draw_range(widget_t* widget, vgcanvas_t* vg,
+                                         const polygon_geometry_t* geo, color_t color,
+                                         const char* image, uint32_t from_offset,
+                                         const polygon_point_t* from, uint32_t to_offset,
+                                         const polygon_point_t* to) {
+  return_value_if_fail(widget != NULL && vg != NULL && geo != NULL, RET_BAD_PARAMS);
 
-  iter = progress_polygon->points.points + offset;
-  include_end = iter->value > end->value;
-  n = include_end ? offset : offset + 1;
+  return_value_if_fail(from != NULL && to != NULL, RET_BAD_PARAMS);
 
-  iter = progress_polygon->points.points;
   vgcanvas_begin_path(vg);
-  progress_polygon_move_to(widget, vg, iter->x1, iter->y1);
-  for (i = 1; i < n; i++) {
-    iter = progress_polygon->points.points + i;
-    progress_polygon_line_to(widget, vg, iter->x1, iter->y1);
-  }
-
-  if (include_end) {
-    progress_polygon_line_to(widget, vg, end->x1, end->y1);
-    progress_polygon_line_to(widget, vg, end->x2, end->y2);
-  }
+  polygon_path_add_range(vg, geo, 0, 0, from_offset, from, to_offset, to);
+  progress_polygon_fill(widget, vg, color, image);
 
-  for (i = n - 1; i >= 0; i--) {
-    iter = progress_polygon->points.points + i;
-    progress_polygon_line_to(widget, vg, iter->x2, iter->y2);
-  }
+  return RET_OK;
+}
 
-  vgcanvas_close_path(vg);
-  progress_polygon_fill(widget, vg, fg_color, fg_image);
+static void progress_polygon_lerp_point(const polygon_geometry_t* geo, uint32_t next, float value,
+                                        polygon_point_t* p) {
+  uint32_t prev = next - 1;
+  float t = (value - geo->values[prev]) / (geo->values[next] - geo->values[prev]);
 
-  return RET_OK;
+  p->value = value;
+  p->x1 = geo->x1[prev] + (geo->x1[next] - geo->x1[prev]) * t;
+  p->y1 = geo->y1[prev] + (geo->y1[next] - geo->y1[prev]) * t;
+  p->x2 = geo->x2[prev] + (geo->x2[next] - geo->x2[prev]) * t;
+  p->y2 = geo->y2[prev] + (geo->y2[next] - geo->y2[prev]) * t;
 }
 
-static ret_t progress_polygon_draw_bg(widget_t* widget, vgcanvas_t* vg, color_t bg_color,
-                                      const char* bg_image, int32_t offset,
-                                      const polygon_point_t* start) {
-  int32_t i = 0;
-  int32_t n = 0;
-  polygon_point_t* iter = NULL;
-  bool_t include_start = FALSE;
-  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
-  return_value_if_fail(widget != NULL && vg != NULL && start != NULL, RET_BAD_PARAMS);
+static void progress_polygon_get_point(const polygon_geometry_t* geo, uint32_t i,
+                                       polygon_point_t* p) {
+  p->value = geo->values[i];
+  p->x1 = geo->x1[i];
+  p->y1 = geo->y1[i];
+  p->x2 = geo->x2[i];
+  p->y2 = geo->y2[i];
+}
 
-  iter = progress_polygon->points.points + offset;
-  include_start = iter->value > start->value;
+/*a 到 b 之间经过第 first 到 last-1 个点，c 不为空时再延伸到 c*/
+static ret_t progress_polygon_draw_run(vgcanvas_t* vg, const polygon_geometry_t* geo,
+                                       uint32_t first, uint32_t last, const polygon_point_t* a,
+                                       const polygon_point_t* b, const polygon_point_t* c,
+                                       color_t ca, color_t cb) {
+  uint32_t i = 0;
 
   vgcanvas_begin_path(vg);
-  if (include_start) {
-    progress_polygon_move_to(widget, vg, start->x1, start->y1);
-  } else {
-    progress_polygon_move_to(widget, vg, iter->x1, iter->y1);
+  vgcanvas_move_to(vg, a->x1, a->y1);
+  for (i = first; i < last; i++) {
+    vgcanvas_line_to(vg, geo->x1[i], geo->y1[i]);
   }
-
-  n = progress_polygon->points.size;
-  for (i = offset; i < n; i++) {
-    iter = progress_polygon->points.points + i;
-    progress_polygon_line_to(widget, vg, iter->x1, iter->y1);
+  vgcanvas_line_to(vg, b->x1, b->y1);
+  if (c != NULL) {
+    vgcanvas_line_to(vg, c->x1, c->y1);
+    vgcanvas_line_to(vg, c->x2, c->y2);
   }
-
-  for (i = n - 1; i >= offset; i--) {
-    iter = progress_polygon->points.points + i;
-    progress_polygon_line_to(widget, vg, iter->x2, iter->y2);
+  vgcanvas_line_to(vg, b->x2, b->y2);
+  for (i = last; i > first; i--) {
+    vgcanvas_line_to(vg, geo->x2[i - 1], geo->y2[i - 1]);
   }
+  vgcanvas_line_to(vg, a->x2, a->y2);
+  vgcanvas_close_path(vg);
 
-  if (include_start) {
-    progress_polygon_line_to(widget, vg, start->x2, start->y2);
-  }
+  vgcanvas_set_fill_linear_gradient(vg, (a->x1 + a->x2) / 2, (a->y1 + a->y2) / 2,
+                                    (b->x1 + b->x2) / 2, (b->y1 + b->y2) / 2, ca, cb);
+  vgcanvas_fill(vg);
 
-  vgcanvas_close_path(vg);
-  progress_polygon_fill(widget, vg, bg_color, bg_image);
+  return RET_OK;
+}
+
+static ret_t progress_polygon_draw_gradient(vgcanvas_t* vg, const polygon_gradient_t* gradient,
+                                            float from, float to) {
+  uint32_t i = 0;
+  uint32_t end = 0;
+  uint32_t last = 0;
+  uint32_t offset = 0;
+  color_t ca, cb;
+  polygon_point_t a, b, c;
+  const polygon_geometry_t* geo = NULL;
+  return_value_if_fail(vg != NULL && gradient != NULL, RET_BAD_PARAMS);
+
+  geo = &(gradient->strips);
+  polygon_geometry_get_boundary(geo, from, &offset, &a);
+  ca = polygon_gradient_get_color(gradient, a.value);
+  i = geo->values[offset] > a.value ? offset : offset + 1;
+
+  /*同一个关键点区间内的条带合并成一段，每段在两端的颜色之间线性渐变，只填充一次*/
+  while (i < geo->size && a.value < to) {
+    bool_t extend = FALSE;
+
+    end = polygon_gradient_get_run_end(gradient, i > 0 ? i - 1 : 0);
+    last = i;
+    while (last < end && geo->values[last] < to) {
+      last++;
+    }
+
+    if (geo->values[last] < to) {
+      progress_polygon_get_point(geo, last, &b);
+      cb = gradient->strip_colors[last];
+    } else {
+      progress_polygon_lerp_point(geo, last, to, &b);
+      cb = polygon_gradient_get_color(gradient, to);
+    }
+
+    /*不透明时延伸到下一段中，由下一段覆盖，避免抗锯齿在接缝处留下细线*/
+    if (b.value < to && last + 1 < geo->size && ca.rgba.a == 0xff && cb.rgba.a == 0xff) {
+      extend = TRUE;
+      if (geo->values[last + 1] < to) {
+        progress_polygon_get_point(geo, last + 1, &c);
+      } else {
+        progress_polygon_lerp_point(geo, last + 1, to, &c);
+      }
+    }
+
+    progress_polygon_draw_run(vg, geo, i, last, &a, &b, extend ? &c : NULL, ca, cb);
+    a = b;
+    ca = cb;
+    i = last + 1;
+  }
 
   return RET_OK;
 }
@@ -352,12 +1213,15 @@ static ret_t progress_polygon_on_paint_border(widget_t* widget, canvas_t* c) {
 
 static ret_t progress_polygon_on_paint_self(widget_t* widget, canvas_t* c) {
   uint32_t offset = 0;
-  double value = 0;
+  uint32_t start_offset = 0;
+  double start = 0;
   double progress = 0;
-  double interpolate = 0;
   style_t* style = widget->astyle;
-  polygon_point_t* next = NULL;
-  polygon_point_t* prev = NULL;
+  const polygon_geometry_t* geo = NULL;
+  polygon_gradient_t* gradient = NULL;
+  polygon_point_t first_point = {0, 0, 0, 0};
+  polygon_point_t last_point = {0, 0, 0, 0};
+  polygon_point_t start_point = {0, 0, 0, 0};
   polygon_point_t boundary_point = {0, 0, 0, 0};
   color_t transparent = color_init(0x00, 0x00, 0x00, 0x00);
   color_t bg_color = style_get_color(style, STYLE_ID_BG_COLOR, transparent);
@@ -365,64 +1229,162 @@ static ret_t progress_polygon_on_paint_self(widget_t* widget, canvas_t* c) {
   color_t border_color = style_get_color(style, STYLE_ID_BORDER_COLOR, transparent);
   const char* bg_image = style_get_str(style, STYLE_ID_BG_IMAGE, NULL);
   const char* fg_image = style_get_str(style, STYLE_ID_FG_IMAGE, NULL);
+  const char* fg_gradient = style_get_str(style, PROGRESS_POLYGON_STYLE_FG_GRADIENT, NULL);
   uint32_t line_width = style_get_int(style, STYLE_ID_BORDER_WIDTH, 1);
   progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
   vgcanvas_t* vg = canvas_get_vgcanvas(c);
   return_value_if_fail(progress_polygon != NULL && vg != NULL, RET_BAD_PARAMS);
-  return_value_if_fail(progress_polygon->points.size > 0, RET_BAD_PARAMS);
+  return_value_if_fail(progress_polygon_prepare(widget) == RET_OK, RET_BAD_PARAMS);
   return_value_if_fail(style != NULL, RET_BAD_PARAMS);
-  return_value_if_fail(vg != NULL, RET_BAD_PARAMS);
   return_value_if_fail(progress_polygon->max > progress_polygon->min, RET_BAD_PARAMS);
 
-  value = tk_clamp(progress_polygon->value, progress_polygon->min, progress_polygon->max);
-  progress = (value - progress_polygon->min) / (progress_polygon->max - progress_polygon->min);
-  offset = polygon_points_find(&progress_polygon->points, progress);
-
-  next = progress_polygon->points.points + offset;
-  prev = offset > 0 ? progress_polygon->points.points + offset - 1 : next;
-  return_value_if_fail(next != NULL, RET_BAD_PARAMS);
-
-  if (prev != next) {
-    interpolate = (progress - prev->value) / (next->value - prev->value);
-    boundary_point.value = progress;
-    boundary_point.x1 = prev->x1 + (next->x1 - prev->x1) * interpolate;
-    boundary_point.y1 = prev->y1 + (next->y1 - prev->y1) * interpolate;
-    boundary_point.x2 = prev->x2 + (next->x2 - prev->x2) * interpolate;
-    boundary_point.y2 = prev->y2 + (next->y2 - prev->y2) * interpolate;
-  } else {
-    boundary_point = *next;
+  geo = &progress_polygon->geometry;
+  start = progress_polygon_value_to_progress(progress_polygon, progress_polygon->start_value);
+  progress = progress_polygon_get_progress(progress_polygon);
+  if (start > progress) {
+    double t = start;
+    start = progress;
+    progress = t;
   }
 
+  /*一次查找同时得到两条分界线*/
+  polygon_geometry_get_range(geo, start, progress, &start_offset, &start_point, &offset,
+                             &boundary_point);
+  gradient = progress_polygon_get_fg_gradient(widget, fg_gradient);
+
   vgcanvas_save(vg);
   vgcanvas_translate(vg, c->ox, c->oy);
-  if (progress > 0 && (fg_color.rgba.a > 0 || fg_image != NULL)) {
-    progress_polygon_draw_fg(widget, vg, fg_color, fg_image, offset, &boundary_point);
+  if (progress > start && gradient != NULL) {
+    progress_polygon_draw_gradient(vg, gradient, start, progress);
+  } else if (progress > start && (fg_color.rgba.a > 0 || fg_image != NULL)) {
+    progress_polygon_draw_range(widget, vg, geo, fg_color, fg_image, start_offset, &start_point,
+                                offset, &boundary_point);
   }
 
-  if (progress < 1 && (bg_color.rgba.a > 0 || bg_image != NULL)) {
-    progress_polygon_draw_bg(widget, vg, bg_color, bg_image, offset, &boundary_point);
+  if (bg_color.rgba.a > 0 || bg_image != NULL) {
+    if (start > 0) {
+      progress_polygon_get_point(geo, 0, &first_point);
+      progress_polygon_draw_range(widget, vg, geo, bg_color, bg_image, 0, &first_point,
+                                  start_offset, &start_point);
+    }
+
+    if (progress < 1) {
+      progress_polygon_get_point(geo, geo->size - 1, &last_point);
+      progress_polygon_draw_range(widget, vg, geo, bg_color, bg_image, offset, &boundary_point,
+                                  geo->size - 1, &last_point);
+    }
   }
 
   if (border_color.rgba.a > 0) {
-    pogress_polygon_draw_border(widget, vg, border_color, line_width);
+    progress_polygon_draw_border(vg, geo, border_color, line_width);
   }
   vgcanvas_restore(vg);
 
   return RET_OK;
 }
 
+static ret_t progress_polygon_dispatch_value_change(widget_t* widget, uint32_t type,
+                                                   double old_value, double new_value) {
+  value_change_event_t evt;
+
+  value_change_event_init(&evt, type, widget);
+  value_set_double(&(evt.old_value), old_value);
+  value_set_double(&(evt.new_value), new_value);
+
+  return widget_dispatch(widget, (event_t*)&evt);
+}
+
+static ret_t progress_polygon_on_pointer(widget_t* widget, xy_t x, xy_t y) {
+  double value = 0;
+  double old_value = 0;
+  point_t p = {x, y};
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
+
+  widget_to_local(widget, &p);
+  if (progress_polygon_get_value_at(widget, p.x, p.y, &value) != RET_OK) {
+    return RET_NOT_FOUND;
+  }
+
+  old_value = progress_polygon->value;
+  if (value != old_value) {
+    progress_polygon_anim_stop(widget);
+    progress_polygon->value = value;
+    progress_polygon_dispatch_value_change(widget, EVT_VALUE_CHANGING, old_value, value);
+    progress_polygon_invalidate_band(widget, old_value, value);
+  }
+
+  return RET_OK;
+}
+
 static ret_t progress_polygon_on_event(widget_t* widget, event_t* e) {
   progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widget);
   return_value_if_fail(widget != NULL && progress_polygon != NULL, RET_BAD_PARAMS);
 
-  (void)progress_polygon;
+  if (!progress_polygon->editable) {
+    return RET_OK;
+  }
+
+  switch (e->type) {
+    case EVT_POINTER_DOWN: {
+      pointer_event_t* evt = (pointer_event_t*)e;
+      progress_polygon->drag_start_value = progress_polygon->value;
+      if (progress_polygon_on_pointer(widget, evt->x, evt->y) == RET_OK) {
+        progress_polygon->dragging = TRUE;
+        widget_grab(widget->parent, widget);
+      }
+      break;
+    }
+    case EVT_POINTER_MOVE: {
+      pointer_event_t* evt = (pointer_event_t*)e;
+      if (progress_polygon->dragging) {
+        progress_polygon_on_pointer(widget, evt->x, evt->y);
+      }
+      break;
+    }
+    case EVT_POINTER_UP: {
+      if (progress_polygon->dragging) {
+        progress_polygon->dragging = FALSE;
+        widget_ungrab(widget->parent, widget);
+        if (progress_polygon->value != progress_polygon->drag_start_value) {
+          progress_polygon_dispatch_value_change(widget, EVT_VALUE_CHANGED,
+                                                 progress_polygon->drag_start_value,
+                                                 progress_polygon->value);
+        }
+      }
+      break;
+    }
+    case EVT_POINTER_DOWN_ABORT: {
+      if (progress_polygon->dragging) {
+        double old_value = progress_polygon->value;
+
+        progress_polygon->dragging = FALSE;
+        widget_ungrab(widget->parent, widget);
+
+        /*取消拖动时恢复原来的值，只处理 EVT_VALUE_CHANGED 的监听者不会看到中间的值*/
+        if (old_value != progress_polygon->drag_start_value) {
+          progress_polygon->value = progress_polygon->drag_start_value;
+          progress_polygon_dispatch_value_change(widget, EVT_VALUE_CHANGING, old_value,
+                                                 progress_polygon->value);
+          progress_polygon_invalidate_band(widget, old_value, progress_polygon->value);
+        }
+      }
+      break;
+    }
+    default:
+      break;
+  }
 
   return RET_OK;
 }
 
 const char* s_progress_polygon_properties[] = {PROGRESS_POLYGON_PROP_VALUE,
+                                               PROGRESS_POLYGON_PROP_START_VALUE,
                                                PROGRESS_POLYGON_PROP_MIN, PROGRESS_POLYGON_PROP_MAX,
-                                               PROGRESS_POLYGON_PROP_POLYGON, NULL};
+                                               PROGRESS_POLYGON_PROP_POLYGON,
+                                               PROGRESS_POLYGON_PROP_KEEP_POLYGON,
+                                               PROGRESS_POLYGON_PROP_EDITABLE,
+                                               PROGRESS_POLYGON_PROP_MORPH_DURATION,
+                                               PROGRESS_POLYGON_PROP_VALUE_ANIMATION, NULL};
 
 TK_DECL_VTABLE(progress_polygon) = {.size = sizeof(progress_polygon_t),
                                     .type = WIDGET_TYPE_PROGRESS_POLYGON,
@@ -444,6 +1406,8 @@ widget_t* progress_polygon_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t
   return_value_if_fail(progress_polygon != NULL, NULL);
 
   progress_polygon->max = 100;
+  progress_polygon->keep_polygon = TRUE;
+  progress_polygon->morph_duration = 500;
 
   return widget;
 }
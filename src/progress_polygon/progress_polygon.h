@@ -23,25 +23,33 @@
 #ifndef TK_PROGRESS_POLYGON_H
 #define TK_PROGRESS_POLYGON_H
 
+#include "tkc/easing.h"
 #include "base/widget.h"
+#include "polygon_hit_grid.h"
+#include "polygon_morph.h"
+#include "polygon_gradient.h"
+#include "polygon_worker.h"
 
 BEGIN_C_DECLS
 
-typedef struct _polygon_point_t {
-  double value;
-  float x1;
-  float y1;
-  float x2;
-  float y2;
-} polygon_point_t;
-
-/*format [(0, 0, 0, 0, 30), (1, 100, 0, 100, 30)]*/
+/*变形过程中的状态，只在变形时分配*/
+typedef struct _progress_polygon_morphing_t {
+  char* target;
+  uint32_t time;
+  uint32_t timer_id;
+  uint64_t start;
+  polygon_morph_t morph;
+} progress_polygon_morphing_t;
 
-typedef struct _polygon_point_array_t {
-  uint32_t size;
-  uint32_t capacity;
-  polygon_point_t* points;
-} polygon_points_t;
+/*值的动画的状态，只在动画进行时分配*/
+typedef struct _progress_polygon_anim_t {
+  uint32_t timer_id;
+  uint32_t duration;
+  easing_type_t easing;
+  uint64_t start;
+  double from;
+  double to;
+} progress_polygon_anim_t;
 
 /**
  * @class progress_polygon_t
@@ -66,6 +74,12 @@ typedef struct _polygon_point_array_t {
  * </style>
  * </progress_polygon>
  * ```
+ *
+ * 前景也可以使用沿进度方向的渐变色(fg\_gradient)，颜色由进度决定，格式为"[位置:]颜色;..."。如：
+ *
+ * ```xml
+ * <style name="gradient" bg_color="#E0E0E0" fg_gradient="#2196F3;#FFC107;#F44336">
+ * ```
  */
 typedef struct _progress_polygon_t {
   widget_t widget;
@@ -78,6 +92,13 @@ typedef struct _progress_polygon_t {
    */
   double value;
 
+  /**
+   * @property {double} start_value
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 起始值(缺省为0)。前景填充 start\_value 和 value 之间的部分，两边都绘制背景，用于显示一个区间。
+   */
+  double start_value;
+
   /**
    * @property {double} min
    * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
@@ -99,8 +120,56 @@ typedef struct _progress_polygon_t {
    */
   char* polygon;
 
+  /**
+   * @property {bool_t} keep_polygon
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 解析后是否保留 polygon 字符串(缺省TRUE)。
+   * 为TRUE时算好几何数据后释放解析的点，控件大小变化时再重新解析。
+   * 为FALSE时解析后释放字符串，保留解析的点，读取 polygon 属性时再重新生成字符串。
+   */
+  bool_t keep_polygon;
+
+  /**
+   * @property {bool_t} editable
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 是否可以通过点击和拖动来修改值(缺省FALSE)。
+   */
+  bool_t editable;
+
+  /**
+   * @property {uint32_t} morph_duration
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 通过 morph\_to 属性变形时，动画的时间(毫秒，缺省500)。
+   */
+  uint32_t morph_duration;
+
+  /**
+   * @property {char*} value_animation
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 通过 animate\_to 属性修改值时使用的内置动画。格式为"duration=时间(毫秒),easing=缓动函数"，
+   * 如"duration=500,easing=sin_inout"。为空时 animate\_to 直接设置值。
+   *
+   * > value 属性总是立即生效，不受本属性影响。
+   */
+  char* value_animation;
+
   /*private*/
-  polygon_points_t points;
+  bool_t stations_dirty;
+  bool_t dragging;
+  bool_t prewarm_tried;
+  double drag_start_value;
+  /*保留 polygon 字符串时，几何数据准备好后就释放，需要时再解析*/
+  polygon_stations_t stations;
+  polygon_geometry_t geometry;
+  /*不常用的状态在需要时才分配*/
+  polygon_hit_grid_t* hit_grid;
+  progress_polygon_morphing_t* morphing;
+  progress_polygon_anim_t* anim;
+  char* fg_gradient_spec;
+  polygon_gradient_t* fg_gradient;
+  polygon_job_t* prepare_job;
+  uint32_t anim_cfg_duration;
+  easing_type_t anim_cfg_easing;
 } progress_polygon_t;
 
 /**
@@ -139,6 +208,17 @@ widget_t* progress_polygon_cast(widget_t* widget);
  */
 ret_t progress_polygon_set_value(widget_t* widget, double value);
 
+/**
+ * @method progress_polygon_set_start_value
+ * 设置 起始值。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {double} start_value 起始值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t progress_polygon_set_start_value(widget_t* widget, double start_value);
+
 /**
  * @method progress_polygon_set_min
  * 设置 最小值。。
@@ -172,10 +252,135 @@ ret_t progress_polygon_set_max(widget_t* widget, double max);
  */
 ret_t progress_polygon_set_polygon(widget_t* widget, const char* polygon);
 
+/**
+ * @method progress_polygon_set_keep_polygon
+ * 设置 解析后是否保留 polygon 字符串。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {bool_t} keep_polygon 解析后是否保留 polygon 字符串。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t progress_polygon_set_keep_polygon(widget_t* widget, bool_t keep_polygon);
+
+/**
+ * @method progress_polygon_set_editable
+ * 设置 是否可以通过点击和拖动来修改值。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {bool_t} editable 是否可以通过点击和拖动来修改值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t progress_polygon_set_editable(widget_t* widget, bool_t editable);
+
+/**
+ * @method progress_polygon_set_morph_duration
+ * 设置 通过 morph\_to 属性变形时，动画的时间。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {uint32_t} morph_duration 动画的时间(毫秒)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t progress_polygon_set_morph_duration(widget_t* widget, uint32_t morph_duration);
+
+/**
+ * @method progress_polygon_morph_to
+ * 从当前形状平滑地变形到新的多边形描述。
+ *
+ * > 开始时把两个形状重新采样到相同的点，动画过程中只做线性插值。结束后 polygon 属性变为新的描述。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {const char*} polygon 目标多边形描述。
+ * @param {uint32_t} duration 动画的时间(毫秒)，为0时直接设置。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t progress_polygon_morph_to(widget_t* widget, const char* polygon, uint32_t duration);
+
+/**
+ * @method progress_polygon_set_value_animation
+ * 设置 通过 animate\_to 属性修改值时使用的内置动画。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {const char*} value_animation 动画参数，如"duration=500,easing=sin_inout"。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t progress_polygon_set_value_animation(widget_t* widget, const char* value_animation);
+
+/**
+ * @method progress_polygon_animate_to
+ * 以动画方式把值修改为 value。
+ *
+ * > 每一帧根据缓动函数直接计算边界的位置，只刷新两帧之间边界扫过的区域，
+ * > 边界与目标的距离小于 1 像素时提前结束。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {double} value 目标值。
+ * @param {uint32_t} duration 动画的时间(毫秒)，为0时直接设置。
+ * @param {easing_type_t} easing 缓动函数的类型。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t progress_polygon_animate_to(widget_t* widget, double value, uint32_t duration,
+                                  easing_type_t easing);
+
+/**
+ * @method progress_polygon_get_value_at
+ * 获取控件内的点(x, y)对应的值。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {xy_t} x x坐标(控件内的坐标)。
+ * @param {xy_t} y y坐标(控件内的坐标)。
+ * @param {double*} value 返回值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，RET_NOT_FOUND表示点不在多边形内。
+ */
+ret_t progress_polygon_get_value_at(widget_t* widget, xy_t x, xy_t y, double* value);
+
+/**
+ * @method progress_polygon_prewarm
+ * 预热。
+ * 解析多边形描述并计算几何数据。
+ *
+ * > 多边形描述默认在第一次绘制时才解析，可以在空闲时调用本函数提前完成。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t progress_polygon_prewarm(widget_t* widget);
+
+/**
+ * @method progress_polygon_prewarm_all
+ * 在空闲时预热 root 下全部的 progress\_polygon 控件(包括不可见的)。
+ *
+ * > 每次 idle 只处理少量控件，每个控件只尝试一次，全部尝试过后自动删除 idle。
+ * > 一般在窗口第一帧绘制之后调用。
+ * @annotation ["scriptable", "static"]
+ * @param {widget_t*} root 根控件(如窗口)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t progress_polygon_prewarm_all(widget_t* root);
+
 #define PROGRESS_POLYGON_PROP_VALUE "value"
+#define PROGRESS_POLYGON_PROP_START_VALUE "start_value"
 #define PROGRESS_POLYGON_PROP_MIN "min"
 #define PROGRESS_POLYGON_PROP_MAX "max"
 #define PROGRESS_POLYGON_PROP_POLYGON "polygon"
+#define PROGRESS_POLYGON_PROP_KEEP_POLYGON "keep_polygon"
+#define PROGRESS_POLYGON_PROP_EDITABLE "editable"
+#define PROGRESS_POLYGON_PROP_MORPH_TO "morph_to"
+#define PROGRESS_POLYGON_PROP_MORPH_DURATION "morph_duration"
+#define PROGRESS_POLYGON_PROP_VALUE_ANIMATION "value_animation"
+
+/*设置时按 value_animation 以动画方式修改值，读取时返回动画的目标值*/
+#define PROGRESS_POLYGON_PROP_ANIMATE_TO "animate_to"
+
+#define PROGRESS_POLYGON_STYLE_FG_GRADIENT "fg_gradient"
 
 #define WIDGET_TYPE_PROGRESS_POLYGON "progress_polygon"
 
@@ -187,23 +392,13 @@ TK_EXTERN_VTABLE(progress_polygon);
 /*public for test*/
 
 /**
- * @method polygon_points_init
- * 解析多边形描述。
- * @param {polygon_points_t*} arr 多边形描述。
- * @param {const char*} data 多边形描述。
- *
- * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
- */
-ret_t polygon_points_init(polygon_points_t* arr, const char* data);
-
-/**
- * @method polygon_points_deinit
- * 释放多边形描述。
- * @param {polygon_points_t*} arr 多边形描述。
+ * @method progress_polygon_get_mem_size
+ * 获取控件(不包括 widget\_t 基类中的成员)占用的内存(字节)。
+ * @param {widget_t*} widget widget对象。
  *
- * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ * @return {uint32_t} 返回占用的内存。
  */
-ret_t polygon_points_deinit(polygon_points_t* arr);
+uint32_t progress_polygon_get_mem_size(widget_t* widget);
 
 END_C_DECLS
 
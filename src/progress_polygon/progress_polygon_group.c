@@ -0,0 +1,374 @@
+﻿/**
+ * File:   progress_polygon_group.c
+ * Author: AWTK Develop Team
+ * Brief:  合并绘制一组异形进度条。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "progress_polygon.h"
+#include "progress_polygon_group.h"
+#include "polygon_path.h"
+
+ret_t progress_polygon_group_set_batch(widget_t* widget, bool_t batch) {
+  progress_polygon_group_t* group = PROGRESS_POLYGON_GROUP(widget);
+  return_value_if_fail(group != NULL, RET_BAD_PARAMS);
+
+  group->batch = batch;
+  widget_invalidate(widget, NULL);
+
+  return RET_OK;
+}
+
+ret_t progress_polygon_group_get_stat(widget_t* widget, uint32_t* batched, uint32_t* styles) {
+  progress_polygon_group_t* group = PROGRESS_POLYGON_GROUP(widget);
+  return_value_if_fail(group != NULL && batched != NULL && styles != NULL, RET_BAD_PARAMS);
+
+  *batched = group->batched_nr;
+  *styles = group->styles_nr;
+
+  return RET_OK;
+}
+
+static ret_t progress_polygon_group_get_prop(widget_t* widget, const char* name, value_t* v) {
+  progress_polygon_group_t* group = PROGRESS_POLYGON_GROUP(widget);
+  return_value_if_fail(group != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+
+  if (tk_str_eq(PROGRESS_POLYGON_GROUP_PROP_BATCH, name)) {
+    value_set_bool(v, group->batch);
+    return RET_OK;
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static ret_t progress_polygon_group_set_prop(widget_t* widget, const char* name,
+                                             const value_t* v) {
+  return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+
+  if (tk_str_eq(PROGRESS_POLYGON_GROUP_PROP_BATCH, name)) {
+    progress_polygon_group_set_batch(widget, value_bool(v));
+    return RET_OK;
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static ret_t progress_polygon_group_on_destroy(widget_t* widget) {
+  progress_polygon_group_t* group = PROGRESS_POLYGON_GROUP(widget);
+  return_value_if_fail(group != NULL, RET_BAD_PARAMS);
+
+  polygon_batch_deinit(&group->gauges);
+  TKMEM_FREE(group->widgets);
+  group->capacity = 0;
+
+  return RET_OK;
+}
+
+static ret_t progress_polygon_group_ensure_capacity(widget_t* widget, uint32_t capacity) {
+  uint8_t* data = NULL;
+  progress_polygon_group_t* group = PROGRESS_POLYGON_GROUP(widget);
+  return_value_if_fail(group != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(polygon_batch_reset(&group->gauges, capacity) == RET_OK, RET_OOM);
+
+  group->styles_nr = 0;
+  if (capacity <= group->capacity) {
+    return RET_OK;
+  }
+
+  data = (uint8_t*)TKMEM_ALLOC(capacity * (sizeof(widget_t*) + sizeof(uint32_t) +
+                                           sizeof(progress_polygon_group_style_t)));
+  return_value_if_fail(data != NULL, RET_OOM);
+
+  TKMEM_FREE(group->widgets);
+  group->capacity = capacity;
+  group->widgets = (widget_t**)data;
+  group->styles = (progress_polygon_group_style_t*)(group->widgets + capacity);
+  group->style_ids = (uint32_t*)(group->styles + capacity);
+
+  return RET_OK;
+}
+
+static uint32_t progress_polygon_group_find_style(widget_t* widget,
+                                                  const progress_polygon_group_style_t* style) {
+  uint32_t i = 0;
+  progress_polygon_group_t* group = PROGRESS_POLYGON_GROUP(widget);
+
+  /*样式一般只有几种，顺序查找即可*/
+  for (i = 0; i < group->styles_nr; i++) {
+    const progress_polygon_group_style_t* iter = group->styles + i;
+    if (iter->fg_color.color == style->fg_color.color &&
+        iter->bg_color.color == style->bg_color.color &&
+        iter->border_color.color == style->border_color.color &&
+        iter->border_width == style->border_width) {
+      return i;
+    }
+  }
+
+  group->styles[group->styles_nr] = *style;
+
+  return group->styles_nr++;
+}
+
+static ret_t progress_polygon_group_add(widget_t* widget, widget_t* child) {
+  style_t* style = NULL;
+  progress_polygon_t* gauge = NULL;
+  progress_polygon_group_style_t key;
+  color_t transparent = color_init(0x00, 0x00, 0x00, 0x00);
+  progress_polygon_group_t* group = PROGRESS_POLYGON_GROUP(widget);
+
+  if (!WIDGET_IS_INSTANCE_OF(child, progress_polygon) || widget_count_children(child) > 0 ||
+      child->opacity < TK_OPACITY_ALPHA) {
+    return RET_NOT_IMPL;
+  }
+
+  if (child->need_update_style) {
+    widget_update_style(child);
+  }
+
+  /*图片和渐变色需要单独设置填充方式，不能合并*/
+  style = child->astyle;
+  if (style == NULL || style_get_str(style, STYLE_ID_FG_IMAGE, NULL) != NULL ||
+      style_get_str(style, STYLE_ID_BG_IMAGE, NULL) != NULL ||
+      style_get_str(style, PROGRESS_POLYGON_STYLE_FG_GRADIENT, NULL) != NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  gauge = PROGRESS_POLYGON(child);
+  if (gauge->max <= gauge->min || progress_polygon_prewarm(child) != RET_OK) {
+    return RET_NOT_IMPL;
+  }
+
+  key.fg_color = style_get_color(style, STYLE_ID_FG_COLOR, transparent);
+  key.bg_color = style_get_color(style, STYLE_ID_BG_COLOR, transparent);
+  key.border_color = style_get_color(style, STYLE_ID_BORDER_COLOR, transparent);
+  key.border_width = style_get_int(style, STYLE_ID_BORDER_WIDTH, 1);
+  if (key.border_color.rgba.a == 0) {
+    /*没有边框时线宽不影响绘制*/
+    key.border_width = 0;
+  }
+
+  group->widgets[group->gauges.size] = child;
+  group->style_ids[group->gauges.size] = progress_polygon_group_find_style(widget, &key);
+
+  return polygon_batch_add(&group->gauges, &gauge->geometry, gauge->start_value, gauge->value,
+                           gauge->min, gauge->max);
+}
+
+static void progress_polygon_group_get_point(const polygon_geometry_t* geo, uint32_t i,
+                                             polygon_point_t* p) {
+  p->value = geo->values[i];
+  p->x1 = geo->x1[i];
+  p->y1 = geo->y1[i];
+  p->x2 = geo->x2[i];
+  p->y2 = geo->y2[i];
+}
+
+static uint32_t progress_polygon_group_add_paths(widget_t* widget, vgcanvas_t* vg, uint32_t id,
+                                                 bool_t fg) {
+  uint32_t i = 0;
+  uint32_t nr = 0;
+  progress_polygon_group_t* group = PROGRESS_POLYGON_GROUP(widget);
+  const polygon_batch_t* gauges = &group->gauges;
+  const float* start = gauges->progress;
+  const float* progress = gauges->progress + gauges->size;
+
+  for (i = 0; i < gauges->size; i++) {
+    uint32_t offset = 0;
+    uint32_t start_offset = 0;
+    polygon_point_t start_point;
+    polygon_point_t boundary_point;
+    widget_t* iter = group->widgets[i];
+    const polygon_geometry_t* geo = gauges->geos[i];
+
+    if (group->style_ids[i] != id) {
+      continue;
+    }
+
+    polygon_batch_get_range(gauges, i, &start_offset, &start_point, &offset, &boundary_point);
+    if (fg) {
+      if (progress[i] > start[i]) {
+        polygon_path_add_range(vg, geo, iter->x, iter->y, start_offset, &start_point, offset,
+                               &boundary_point);
+        nr++;
+      }
+    } else {
+      if (start[i] > 0) {
+        polygon_point_t first_point;
+        progress_polygon_group_get_point(geo, 0, &first_point);
+        polygon_path_add_range(vg, geo, iter->x, iter->y, 0, &first_point, start_offset,
+                               &start_point);
+        nr++;
+      }
+
+      if (progress[i] < 1) {
+        polygon_point_t last_point;
+        progress_polygon_group_get_point(geo, geo->size - 1, &last_point);
+        polygon_path_add_range(vg, geo, iter->x, iter->y, offset, &boundary_point,
+                               geo->size - 1, &last_point);
+        nr++;
+      }
+    }
+  }
+
+  return nr;
+}
+
+static ret_t progress_polygon_group_draw_style(widget_t* widget, vgcanvas_t* vg, uint32_t id) {
+  uint32_t i = 0;
+  progress_polygon_group_t* group = PROGRESS_POLYGON_GROUP(widget);
+  const progress_polygon_group_style_t* style = group->styles + id;
+
+  /*与 progress_polygon 相同的顺序: 前景、背景、边框，每一层只填充(或描边)一次*/
+  if (style->fg_color.rgba.a > 0) {
+    vgcanvas_begin_path(vg);
+    if (progress_polygon_group_add_paths(widget, vg, id, TRUE) > 0) {
+      vgcanvas_set_fill_color(vg, style->fg_color);
+      vgcanvas_fill(vg);
+    }
+  }
+
+  if (style->bg_color.rgba.a > 0) {
+    vgcanvas_begin_path(vg);
+    if (progress_polygon_group_add_paths(widget, vg, id, FALSE) > 0) {
+      vgcanvas_set_fill_color(vg, style->bg_color);
+      vgcanvas_fill(vg);
+    }
+  }
+
+  if (style->border_color.rgba.a > 0) {
+    uint32_t nr = 0;
+
+    vgcanvas_begin_path(vg);
+    for (i = 0; i < group->gauges.size; i++) {
+      if (group->style_ids[i] == id) {
+        widget_t* iter = group->widgets[i];
+        polygon_path_add_outline(vg, group->gauges.geos[i], iter->x, iter->y);
+        nr++;
+      }
+    }
+
+    if (nr > 0) {
+      vgcanvas_set_line_width(vg, style->border_width);
+      vgcanvas_set_stroke_color(vg, style->border_color);
+      vgcanvas_stroke(vg);
+    }
+  }
+
+  return RET_OK;
+}
+
+static bool_t progress_polygon_group_is_visible(widget_t* child, canvas_t* c, const rect_t* clip) {
+  xy_t left = c->ox + child->x;
+  xy_t top = c->oy + child->y;
+  xy_t right = left + child->w;
+  xy_t bottom = top + child->h;
+
+  if (!child->visible) {
+    return FALSE;
+  }
+
+  return !(left > clip->x + clip->w || right < clip->x || top > clip->y + clip->h ||
+           bottom < clip->y);
+}
+
+/*绘制已经合并的进度条，然后清空，用于保持与逐个绘制相同的叠放次序*/
+static ret_t progress_polygon_group_flush(widget_t* widget, canvas_t* c, vgcanvas_t* vg) {
+  uint32_t i = 0;
+  progress_polygon_group_t* group = PROGRESS_POLYGON_GROUP(widget);
+
+  if (group->gauges.size == 0) {
+    return RET_OK;
+  }
+
+  polygon_batch_compute(&group->gauges);
+  vgcanvas_save(vg);
+  vgcanvas_translate(vg, c->ox, c->oy);
+  for (i = 0; i < group->styles_nr; i++) {
+    progress_polygon_group_draw_style(widget, vg, i);
+  }
+  vgcanvas_restore(vg);
+  group->batched_nr += group->gauges.size;
+
+  return polygon_batch_reset(&group->gauges, group->capacity);
+}
+
+static ret_t progress_polygon_group_on_paint_children(widget_t* widget, canvas_t* c) {
+  rect_t clip;
+  vgcanvas_t* vg = canvas_get_vgcanvas(c);
+  progress_polygon_group_t* group = PROGRESS_POLYGON_GROUP(widget);
+  return_value_if_fail(group != NULL, RET_BAD_PARAMS);
+
+  group->batched_nr = 0;
+  if (!group->batch || vg == NULL ||
+      progress_polygon_group_ensure_capacity(widget, widget_count_children(widget)) != RET_OK) {
+    group->styles_nr = 0;
+    group->gauges.size = 0;
+    return widget_on_paint_children_default(widget, c);
+  }
+
+  canvas_get_clip_rect(c, &clip);
+  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, k)
+  if (!progress_polygon_group_is_visible(iter, c, &clip)) {
+    iter->dirty = FALSE;
+    continue;
+  }
+
+  if (progress_polygon_group_add(widget, iter) == RET_OK) {
+    iter->dirty = FALSE;
+  } else {
+    /*不能合并的子控件可能与前面的子控件重叠，先绘制前面合并的进度条*/
+    progress_polygon_group_flush(widget, c, vg);
+    widget_paint(iter, c);
+  }
+  WIDGET_FOR_EACH_CHILD_END();
+
+  return progress_polygon_group_flush(widget, c, vg);
+}
+
+const char* s_progress_polygon_group_properties[] = {PROGRESS_POLYGON_GROUP_PROP_BATCH, NULL};
+
+TK_DECL_VTABLE(progress_polygon_group) = {
+    .size = sizeof(progress_polygon_group_t),
+    .type = WIDGET_TYPE_PROGRESS_POLYGON_GROUP,
+    .clone_properties = s_progress_polygon_group_properties,
+    .persistent_properties = s_progress_polygon_group_properties,
+    .parent = TK_PARENT_VTABLE(widget),
+    .create = progress_polygon_group_create,
+    .on_paint_children = progress_polygon_group_on_paint_children,
+    .set_prop = progress_polygon_group_set_prop,
+    .get_prop = progress_polygon_group_get_prop,
+    .on_destroy = progress_polygon_group_on_destroy};
+
+widget_t* progress_polygon_group_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
+  widget_t* widget = widget_create(parent, TK_REF_VTABLE(progress_polygon_group), x, y, w, h);
+  progress_polygon_group_t* group = PROGRESS_POLYGON_GROUP(widget);
+  return_value_if_fail(group != NULL, NULL);
+
+  group->batch = TRUE;
+  polygon_batch_init(&group->gauges);
+
+  return widget;
+}
+
+widget_t* progress_polygon_group_cast(widget_t* widget) {
+  return_value_if_fail(WIDGET_IS_INSTANCE_OF(widget, progress_polygon_group), NULL);
+
+  return widget;
+}
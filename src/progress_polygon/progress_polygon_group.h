@@ -0,0 +1,144 @@
+﻿/**
+ * File:   progress_polygon_group.h
+ * Author: AWTK Develop Team
+ * Brief:  合并绘制一组异形进度条。
+ *
+ * Copyright (c) 2024 - 2026 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+
+#ifndef TK_PROGRESS_POLYGON_GROUP_H
+#define TK_PROGRESS_POLYGON_GROUP_H
+
+#include "base/widget.h"
+#include "polygon_batch.h"
+
+BEGIN_C_DECLS
+
+/*样式相同的进度条合并到同一个路径中绘制*/
+typedef struct _progress_polygon_group_style_t {
+  color_t fg_color;
+  color_t bg_color;
+  color_t border_color;
+  uint32_t border_width;
+} progress_polygon_group_style_t;
+
+/**
+ * @class progress_polygon_group_t
+ * @parent widget_t
+ * @annotation ["scriptable","design","widget"]
+ * 异形进度条组。
+ *
+ * 大量的 progress\_polygon 作为它的子控件时，样式相同的进度条的前景、背景和边框分别合并到
+ * 一个路径中，一次填充(或描边)，填充和状态切换的次数只与样式的个数有关，与进度条的个数无关。
+ * 所有进度条的分界线在连续数组上一起计算(请参考 polygon\_batch\_t)。
+ *
+ * 在xml中使用"progress\_polygon\_group"标签创建控件。如：
+ *
+ * ```xml
+ * <!-- ui -->
+ * <progress_polygon_group x="0" y="0" w="100%" h="100%" children_layout="default(c=10,r=20)">
+ *   <progress_polygon polygon="(0, 0,1,0,1)(1, 1,0,1,1)" value="30"/>
+ *   <progress_polygon polygon="(0, 0,1,0,1)(1, 1,0,1,1)" value="60"/>
+ * </progress_polygon_group>
+ * ```
+ *
+ * > 使用图片、渐变色或透明度的进度条，以及其它类型的子控件仍然逐个绘制。绘制它们之前先绘制前面已经
+ * > 合并的进度条，所以它们与前后子控件的叠放次序不变。
+ * > 连续的可合并的进度条先绘制完一种样式再绘制下一种，所以它们之间不要重叠，而且不会触发子控件的绘制事件。
+ */
+typedef struct _progress_polygon_group_t {
+  widget_t widget;
+
+  /**
+   * @property {bool_t} batch
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 是否合并绘制子控件(缺省TRUE)。为FALSE时与普通的容器一样逐个绘制，便于对比。
+   */
+  bool_t batch;
+
+  /*private*/
+  polygon_batch_t gauges;
+  uint32_t capacity;
+  /*以下数组在同一块内存中，widgets 为起始地址*/
+  widget_t** widgets;
+  uint32_t* style_ids;
+  progress_polygon_group_style_t* styles;
+  uint32_t styles_nr;
+  uint32_t batched_nr;
+} progress_polygon_group_t;
+
+/**
+ * @method progress_polygon_group_create
+ * @annotation ["constructor", "scriptable"]
+ * 创建progress_polygon_group对象
+ * @param {widget_t*} parent 父控件
+ * @param {xy_t} x x坐标
+ * @param {xy_t} y y坐标
+ * @param {wh_t} w 宽度
+ * @param {wh_t} h 高度
+ *
+ * @return {widget_t*} progress_polygon_group对象。
+ */
+widget_t* progress_polygon_group_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h);
+
+/**
+ * @method progress_polygon_group_cast
+ * 转换为progress_polygon_group对象(供脚本语言使用)。
+ * @annotation ["cast", "scriptable"]
+ * @param {widget_t*} widget progress_polygon_group对象。
+ *
+ * @return {widget_t*} progress_polygon_group对象。
+ */
+widget_t* progress_polygon_group_cast(widget_t* widget);
+
+/**
+ * @method progress_polygon_group_set_batch
+ * 设置 是否合并绘制子控件。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {bool_t} batch 是否合并绘制子控件。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t progress_polygon_group_set_batch(widget_t* widget, bool_t batch);
+
+#define PROGRESS_POLYGON_GROUP_PROP_BATCH "batch"
+
+#define WIDGET_TYPE_PROGRESS_POLYGON_GROUP "progress_polygon_group"
+
+#define PROGRESS_POLYGON_GROUP(widget) \
+  ((progress_polygon_group_t*)(progress_polygon_group_cast(WIDGET(widget))))
+
+/*public for subclass and runtime type check*/
+TK_EXTERN_VTABLE(progress_polygon_group);
+
+/*public for test*/
+
+/**
+ * @method progress_polygon_group_get_stat
+ * 获取最近一次绘制时合并绘制的进度条的个数和样式的个数。
+ * @param {widget_t*} widget widget对象。
+ * @param {uint32_t*} batched 返回合并绘制的进度条的个数。
+ * @param {uint32_t*} styles 返回样式的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t progress_polygon_group_get_stat(widget_t* widget, uint32_t* batched, uint32_t* styles);
+
+END_C_DECLS
+
+#endif /*TK_PROGRESS_POLYGON_GROUP_H*/
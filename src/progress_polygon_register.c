@@ -25,11 +25,22 @@
 #include "progress_polygon_register.h"
 #include "base/widget_factory.h"
 #include "progress_polygon/progress_polygon.h"
+#include "progress_polygon/progress_polygon_group.h"
+#include "progress_polygon/polygon_worker.h"
+#include "progress_polygon/polygon_pool.h"
 
 ret_t progress_polygon_register(void) {
+  widget_factory_register(widget_factory(), WIDGET_TYPE_PROGRESS_POLYGON_GROUP,
+                          progress_polygon_group_create);
   return widget_factory_register(widget_factory(), WIDGET_TYPE_PROGRESS_POLYGON, progress_polygon_create);
 }
 
+ret_t progress_polygon_unregister(void) {
+  polygon_worker_deinit();
+
+  return polygon_pool_deinit();
+}
+
 const char* progress_polygon_supported_render_mode(void) {
   return "OpenGL|AGGE-BGR565|AGGE-BGRA8888|AGGE-MONO";
 }
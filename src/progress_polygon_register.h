@@ -37,6 +37,18 @@ BEGIN_C_DECLS
  */
 ret_t progress_polygon_register(void);
 
+/**
+ * @method  progress_polygon_unregister
+ * 停止后台线程，释放内存池的锁。
+ *
+ * 在程序退出时调用(可以在控件销毁之前调用)。
+ *
+ * @annotation ["global"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t progress_polygon_unregister(void);
+
 /**
  * @method  progress_polygon_supported_render_mode
  * 获取支持的渲染模式。
@@ -35,6 +35,7 @@
 #include "base/system_info.h"
 #include "gtest/gtest.h"
 #include "demos/assets.h"
+#include "progress_polygon_register.h"
 
 GTEST_API_ int main(int argc, char** argv) {
   printf("Running main() from gtest_main.cc\n");
@@ -44,9 +45,11 @@ GTEST_API_ int main(int argc, char** argv) {
   system_info_init(APP_SIMULATOR, NULL, "./");
   tk_init_internal();
   tk_init_assets();
+  progress_polygon_register();
 
   RUN_ALL_TESTS();
 
+  progress_polygon_unregister();
   tk_deinit_internal();
 
   return 0;
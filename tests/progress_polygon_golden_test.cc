@@ -0,0 +1,471 @@
+﻿#include <stdio.h>
+#include <stdlib.h>
+#include "awtk.h"
+#include "tkc/fs.h"
+#include "tkc/mem.h"
+#include "tkc/str.h"
+#include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "lcd/lcd_mem_bgr565.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "progress_polygon/progress_polygon.h"
+#include "progress_polygon/progress_polygon_group.h"
+#include "gtest/gtest.h"
+
+/*
+ * 像素级的回归测试:
+ * 把 design/default/ui/main.xml 中的每个形状按几种大小和值(包括 0、最大值和正好落在点上的值)
+ * 绘制到 BGRA8888 和 BGR565 的离线画布上，与保存的图片比较，同时记录绘制时间。
+ * 每个形状还放到 progress_polygon_group 中合并绘制一次，与同一张图片比较。
+ *
+ * 通过环境变量配置:
+ *   PROGRESS_POLYGON_GOLDEN_DIR        保存图片的目录(缺省为源码中的 tests/golden)。
+ *   PROGRESS_POLYGON_GOLDEN_OUT        输出目录(缺省为临时目录下的 progress_polygon_golden)。
+ *   PROGRESS_POLYGON_GOLDEN_UPDATE     为 1 时重新生成全部图片(只用单独绘制的结果生成)。
+ *   PROGRESS_POLYGON_GOLDEN_TOLERANCE  每个通道允许的差值(0-255，缺省 0)。
+ *   PROGRESS_POLYGON_GOLDEN_MAX_PIXELS 允许超出 TOLERANCE 的像素个数(缺省 0)。
+ *   PROGRESS_POLYGON_GOLDEN_TIMING     绘制时间的输出文件(缺省为输出目录下的 golden_timing.csv)。
+ *
+ * 没有图片、图片的大小或格式不对以及像素不一致时测试失败(不会自动生成或覆盖图片)，
+ * 实际的图片保存到输出目录下的 golden_failed 目录中，确认无误后可以用 UPDATE 更新。
+ * 除了 UPDATE，测试不会往源码目录中写任何文件。
+ */
+
+#define GOLDEN_MAGIC "PPGI"
+#define GOLDEN_HEADER_SIZE 10
+#define GOLDEN_MAX_RUN 0xffff
+#define GOLDEN_PAINT_TIMES 5
+#define GOLDEN_MAX_SHAPES 32
+#define GOLDEN_MAX_VALUES 64
+
+/*tests/SConscript 中定义为 tests/golden 的绝对路径，不依赖运行时的当前目录*/
+#ifndef PROGRESS_POLYGON_GOLDEN_SRC_DIR
+#define PROGRESS_POLYGON_GOLDEN_SRC_DIR "tests/golden"
+#endif /*PROGRESS_POLYGON_GOLDEN_SRC_DIR*/
+
+typedef struct _golden_shape_t {
+  char* polygon;
+  char* style;
+} golden_shape_t;
+
+typedef struct _golden_config_t {
+  const char* dir;
+  char out[MAX_PATH + 1];
+  char failed[MAX_PATH + 1];
+  char timing[MAX_PATH + 1];
+  bool_t update;
+  uint32_t tolerance;
+  uint32_t max_pixels;
+} golden_config_t;
+
+typedef struct _golden_result_t {
+  uint32_t recorded;
+  uint32_t compared;
+  uint32_t failed;
+} golden_result_t;
+
+static const char* golden_getenv(const char* name, const char* defval) {
+  const char* value = getenv(name);
+
+  return (value != NULL && *value) ? value : defval;
+}
+
+static void golden_config_init(golden_config_t* config) {
+  char temp[MAX_PATH + 1];
+  const char* out = getenv("PROGRESS_POLYGON_GOLDEN_OUT");
+  const char* timing = getenv("PROGRESS_POLYGON_GOLDEN_TIMING");
+
+  memset(temp, 0x00, sizeof(temp));
+  memset(config, 0x00, sizeof(golden_config_t));
+  config->dir = golden_getenv("PROGRESS_POLYGON_GOLDEN_DIR", PROGRESS_POLYGON_GOLDEN_SRC_DIR);
+
+  /*输出的文件默认放到临时目录中，不写到源码目录或者当前目录*/
+  if (out != NULL && *out) {
+    tk_strncpy(config->out, out, MAX_PATH);
+  } else {
+    if (fs_get_temp_path(os_fs(), temp) != RET_OK) {
+      tk_strncpy(temp, ".", MAX_PATH);
+    }
+    tk_snprintf(config->out, MAX_PATH, "%s/progress_polygon_golden", temp);
+  }
+  tk_snprintf(config->failed, MAX_PATH, "%s/golden_failed", config->out);
+  if (timing != NULL && *timing) {
+    tk_strncpy(config->timing, timing, MAX_PATH);
+  } else {
+    tk_snprintf(config->timing, MAX_PATH, "%s/golden_timing.csv", config->out);
+  }
+
+  config->update = tk_atoi(golden_getenv("PROGRESS_POLYGON_GOLDEN_UPDATE", "0")) != 0;
+  config->tolerance = tk_atoi(golden_getenv("PROGRESS_POLYGON_GOLDEN_TOLERANCE", "0"));
+  config->max_pixels = tk_atoi(golden_getenv("PROGRESS_POLYGON_GOLDEN_MAX_PIXELS", "0"));
+}
+
+static uint32_t golden_hash(const char* str) {
+  /*FNV-1a，形状改变后文件名也会改变*/
+  uint32_t hash = 2166136261u;
+
+  for (; *str; str++) {
+    hash = (hash ^ (uint8_t)*str) * 16777619u;
+  }
+
+  return hash;
+}
+
+static void golden_put_u16(uint8_t* p, uint32_t v) {
+  p[0] = v & 0xff;
+  p[1] = (v >> 8) & 0xff;
+}
+
+static uint32_t golden_get_u16(const uint8_t* p) {
+  return p[0] | (p[1] << 8);
+}
+
+/*头部: magic(4) w(2) h(2) bpp(2)，之后为游程编码的像素: 个数(2) 像素(bpp)*/
+static ret_t golden_save(const char* filename, const uint8_t* pixels, wh_t w, wh_t h,
+                         uint32_t bpp) {
+  ret_t ret = RET_OK;
+  uint32_t i = 0;
+  uint32_t size = 0;
+  uint32_t nr = w * h;
+  uint8_t* data = (uint8_t*)TKMEM_ALLOC(GOLDEN_HEADER_SIZE + nr * (2 + bpp));
+  return_value_if_fail(data != NULL, RET_OOM);
+
+  memcpy(data, GOLDEN_MAGIC, 4);
+  golden_put_u16(data + 4, w);
+  golden_put_u16(data + 6, h);
+  golden_put_u16(data + 8, bpp);
+  size = GOLDEN_HEADER_SIZE;
+
+  while (i < nr) {
+    uint32_t run = 1;
+    const uint8_t* p = pixels + i * bpp;
+
+    while (i + run < nr && run < GOLDEN_MAX_RUN && memcmp(p, p + run * bpp, bpp) == 0) {
+      run++;
+    }
+
+    golden_put_u16(data + size, run);
+    memcpy(data + size + 2, p, bpp);
+    size += 2 + bpp;
+    i += run;
+  }
+
+  ret = file_write(filename, data, size);
+  TKMEM_FREE(data);
+
+  return ret;
+}
+
+static ret_t golden_load(const char* filename, wh_t w, wh_t h, uint32_t bpp, uint8_t** result) {
+  uint32_t i = 0;
+  uint32_t size = 0;
+  uint32_t offset = GOLDEN_HEADER_SIZE;
+  uint32_t nr = w * h;
+  uint8_t* pixels = NULL;
+  uint8_t* data = (uint8_t*)file_read(filename, &size);
+
+  *result = NULL;
+  if (data == NULL) {
+    return RET_NOT_FOUND;
+  }
+
+  if (size < GOLDEN_HEADER_SIZE || memcmp(data, GOLDEN_MAGIC, 4) != 0 ||
+      golden_get_u16(data + 4) != (uint32_t)w || golden_get_u16(data + 6) != (uint32_t)h ||
+      golden_get_u16(data + 8) != bpp) {
+    TKMEM_FREE(data);
+    return RET_BAD_PARAMS;
+  }
+
+  pixels = TKMEM_ZALLOCN(uint8_t, nr * bpp);
+  while (pixels != NULL && i < nr && offset + 2 + bpp <= size) {
+    uint32_t j = 0;
+    uint32_t run = tk_min(golden_get_u16(data + offset), nr - i);
+
+    for (j = 0; j < run; j++, i++) {
+      memcpy(pixels + i * bpp, data + offset + 2, bpp);
+    }
+    offset += 2 + bpp;
+  }
+  TKMEM_FREE(data);
+  return_value_if_fail(pixels != NULL, RET_OOM);
+
+  if (i != nr) {
+    TKMEM_FREE(pixels);
+    return RET_FAIL;
+  }
+  *result = pixels;
+
+  return RET_OK;
+}
+
+static void golden_get_rgba(const uint8_t* p, uint32_t bpp, uint8_t rgba[4]) {
+  if (bpp == 2) {
+    /*565 展开为 8 位后比较，通道的顺序不影响差值*/
+    uint32_t v = golden_get_u16(p);
+    rgba[0] = ((v >> 11) & 0x1f) * 255 / 31;
+    rgba[1] = ((v >> 5) & 0x3f) * 255 / 63;
+    rgba[2] = (v & 0x1f) * 255 / 31;
+    rgba[3] = 0xff;
+  } else {
+    memcpy(rgba, p, 4);
+  }
+}
+
+static uint32_t golden_compare(const uint8_t* a, const uint8_t* b, wh_t w, wh_t h, uint32_t bpp,
+                               uint32_t tolerance, uint32_t* max_diff) {
+  uint32_t i = 0;
+  uint32_t k = 0;
+  uint32_t pixels = 0;
+
+  *max_diff = 0;
+  for (i = 0; i < (uint32_t)(w * h); i++) {
+    uint32_t diff = 0;
+    uint8_t ca[4];
+    uint8_t cb[4];
+
+    golden_get_rgba(a + i * bpp, bpp, ca);
+    golden_get_rgba(b + i * bpp, bpp, cb);
+    for (k = 0; k < 4; k++) {
+      diff = tk_max(diff, (uint32_t)tk_abs((int32_t)ca[k] - (int32_t)cb[k]));
+    }
+
+    *max_diff = tk_max(*max_diff, diff);
+    if (diff > tolerance) {
+      pixels++;
+    }
+  }
+
+  return pixels;
+}
+
+static ret_t golden_collect_visit(void* ctx, const void* data) {
+  widget_t* widget = WIDGET(data);
+  darray_t* shapes = (darray_t*)ctx;
+
+  if (WIDGET_IS_INSTANCE_OF(widget, progress_polygon)) {
+    golden_shape_t* shape = TKMEM_ZALLOC(golden_shape_t);
+    return_value_if_fail(shape != NULL, RET_OOM);
+
+    shape->polygon = tk_strdup(widget_get_prop_str(widget, PROGRESS_POLYGON_PROP_POLYGON, ""));
+    shape->style = tk_strdup(widget->style != NULL ? widget->style : "default");
+    darray_push(shapes, shape);
+  }
+
+  return RET_OK;
+}
+
+static ret_t golden_shape_destroy(void* data) {
+  golden_shape_t* shape = (golden_shape_t*)data;
+
+  TKMEM_FREE(shape->polygon);
+  TKMEM_FREE(shape->style);
+  TKMEM_FREE(shape);
+
+  return RET_OK;
+}
+
+/*0、最大值、每个点的值和一个中间值*/
+static uint32_t golden_get_values(const char* polygon, double* values) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t nr = 0;
+  polygon_stations_t stations;
+
+  values[nr++] = 0;
+  values[nr++] = 100;
+  values[nr++] = 37.5;
+  if (polygon_stations_init(&stations, polygon) == RET_OK) {
+    const float* v = POLYGON_STATIONS_VALUES(&stations);
+
+    for (i = 0; i < stations.size && nr < GOLDEN_MAX_VALUES; i++) {
+      double value = (double)v[i] * 100;
+
+      for (j = 0; j < nr; j++) {
+        if (values[j] == value) {
+          break;
+        }
+      }
+
+      if (j == nr) {
+        values[nr++] = value;
+      }
+    }
+    polygon_stations_deinit(&stations);
+  }
+
+  return nr;
+}
+
+static uint32_t golden_render(const golden_shape_t* shape, wh_t w, wh_t h, double value,
+                              bool_t bgr565, bool_t grouped, uint8_t* pixels) {
+  canvas_t c;
+  uint32_t i = 0;
+  uint64_t best = 0;
+  rect_t r = rect_init(0, 0, w, h);
+  lcd_t* lcd = bgr565 ? lcd_mem_bgr565_create_single_fb(w, h, pixels)
+                      : lcd_mem_bgra8888_create_single_fb(w, h, pixels);
+  widget_t* win = window_create(NULL, 0, 0, w, h);
+  widget_t* target = NULL;
+  widget_t* gauge = NULL;
+
+  widget_set_prop_str(win, WIDGET_PROP_THEME, "main");
+  target = grouped ? progress_polygon_group_create(win, 0, 0, w, h) : win;
+  gauge = progress_polygon_create(target, 0, 0, w, h);
+  widget_use_style(gauge, shape->style);
+  progress_polygon_set_polygon(gauge, shape->polygon);
+  progress_polygon_set_value(gauge, value);
+  progress_polygon_prewarm(gauge);
+  polygon_worker_flush();
+  if (!grouped) {
+    target = gauge;
+  }
+
+  /*多次绘制，取最短的时间*/
+  canvas_init(&c, lcd, font_manager());
+  for (i = 0; i < GOLDEN_PAINT_TIMES; i++) {
+    uint64_t start = 0;
+    uint64_t cost = 0;
+
+    canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+    canvas_set_fill_color(&c, color_init(0xff, 0xff, 0xff, 0xff));
+    canvas_fill_rect(&c, 0, 0, w, h);
+    start = time_now_us();
+    widget_paint(target, &c);
+    cost = time_now_us() - start;
+    canvas_end_frame(&c);
+
+    best = i == 0 ? cost : tk_min(best, cost);
+  }
+
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+  widget_destroy(win);
+
+  return (uint32_t)best;
+}
+
+static void golden_save_failed(const golden_config_t* config, const char* name,
+                               const uint8_t* pixels, wh_t w, wh_t h, uint32_t bpp,
+                               bool_t grouped) {
+  char failed[MAX_PATH + 1];
+
+  tk_snprintf(failed, MAX_PATH, "%s/%s%s", config->failed, grouped ? "group_" : "", name);
+  fs_create_dir_r(os_fs(), config->failed);
+  golden_save(failed, pixels, w, h, bpp);
+}
+
+static void golden_check(const golden_config_t* config, golden_result_t* result, FILE* timing,
+                         uint32_t index, const golden_shape_t* shape, wh_t w, wh_t h,
+                         double value, bool_t bgr565, bool_t grouped) {
+  ret_t ret = RET_OK;
+  char name[MAX_PATH + 1];
+  char filename[MAX_PATH + 1];
+  uint32_t bpp = bgr565 ? 2 : 4;
+  uint32_t max_diff = 0;
+  uint32_t diff_pixels = 0;
+  uint8_t* golden = NULL;
+  uint8_t* pixels = TKMEM_ZALLOCN(uint8_t, w * h * bpp);
+  uint32_t cost = 0;
+  ASSERT_TRUE(pixels != NULL);
+
+  tk_snprintf(name, MAX_PATH, "s%02u_%08x_%ux%u_v%.4f_%s.golden", index,
+              golden_hash(shape->polygon), w, h, value, bgr565 ? "bgr565" : "bgra8888");
+  tk_snprintf(filename, MAX_PATH, "%s/%s", config->dir, name);
+  cost = golden_render(shape, w, h, value, bgr565, grouped, pixels);
+
+  /*合并绘制与单独绘制使用同一张图片，只用单独绘制的结果生成*/
+  if (config->update && !grouped) {
+    EXPECT_EQ(golden_save(filename, pixels, w, h, bpp), RET_OK) << filename;
+    result->recorded++;
+  } else if ((ret = golden_load(filename, w, h, bpp, &golden)) != RET_OK) {
+    golden_save_failed(config, name, pixels, w, h, bpp, grouped);
+    result->failed++;
+    ADD_FAILURE() << filename
+                  << (ret == RET_NOT_FOUND ? ": not found" : ": bad size, format or data")
+                  << ", set PROGRESS_POLYGON_GOLDEN_UPDATE=1 to generate it";
+  } else {
+    diff_pixels = golden_compare(golden, pixels, w, h, bpp, config->tolerance, &max_diff);
+    result->compared++;
+    if (diff_pixels > config->max_pixels) {
+      golden_save_failed(config, name, pixels, w, h, bpp, grouped);
+      result->failed++;
+    }
+
+    EXPECT_LE(diff_pixels, config->max_pixels)
+        << name << (grouped ? " (group)" : "") << ": max diff " << max_diff << ", see "
+        << config->failed;
+    TKMEM_FREE(golden);
+  }
+
+  if (timing != NULL) {
+    fprintf(timing, "%s,%s,%s,%u,%u,%g,%u,%u,%u\n", name, bgr565 ? "bgr565" : "bgra8888",
+            grouped ? "group" : "widget", w, h, value, cost, max_diff, diff_pixels);
+  }
+  TKMEM_FREE(pixels);
+}
+
+TEST(progress_polygon_golden, main_xml) {
+  uint32_t i = 0;
+  uint32_t s = 0;
+  uint32_t v = 0;
+  uint32_t f = 0;
+  uint32_t g = 0;
+  uint64_t start = 0;
+  darray_t shapes;
+  golden_config_t config;
+  golden_result_t result;
+  FILE* timing = NULL;
+  widget_t* win = NULL;
+  double values[GOLDEN_MAX_VALUES];
+  static const wh_t sizes[][2] = {{64, 24}, {160, 60}, {301, 109}};
+
+  golden_config_init(&config);
+  memset(&result, 0x00, sizeof(result));
+  darray_init(&shapes, GOLDEN_MAX_SHAPES, golden_shape_destroy, NULL);
+
+  /*main.xml 中的全部形状(多边形和样式)*/
+  win = window_open("main");
+  ASSERT_TRUE(win != NULL);
+  widget_foreach(win, golden_collect_visit, &shapes);
+  widget_destroy(win);
+  ASSERT_GT(shapes.size, 0u);
+
+  /*只有重新生成图片时才写源码目录*/
+  if (config.update) {
+    ASSERT_EQ(fs_create_dir_r(os_fs(), config.dir), RET_OK);
+  }
+  fs_create_dir_r(os_fs(), config.out);
+  timing = fopen(config.timing, "w");
+  if (timing != NULL) {
+    fprintf(timing, "name,format,mode,w,h,value,paint_us,max_diff,diff_pixels\n");
+  }
+
+  start = time_now_us();
+  for (i = 0; i < shapes.size; i++) {
+    const golden_shape_t* shape = (const golden_shape_t*)darray_get(&shapes, i);
+    uint32_t values_nr = golden_get_values(shape->polygon, values);
+
+    for (s = 0; s < ARRAY_SIZE(sizes); s++) {
+      for (v = 0; v < values_nr; v++) {
+        for (f = 0; f < 2; f++) {
+          for (g = 0; g < 2; g++) {
+            golden_check(&config, &result, timing, i, shape, sizes[s][0], sizes[s][1], values[v],
+                         f == 1, g == 1);
+          }
+        }
+      }
+    }
+  }
+
+  if (timing != NULL) {
+    fclose(timing);
+  }
+
+  RecordProperty("shapes", shapes.size);
+  RecordProperty("compared", result.compared);
+  RecordProperty("recorded", result.recorded);
+  RecordProperty("failed", result.failed);
+  RecordProperty("ms", (int)((time_now_us() - start) / 1000));
+  RecordProperty("timing", config.timing);
+  darray_deinit(&shapes);
+}
@@ -1,75 +1,119 @@
-﻿#include "progress_polygon/progress_polygon.h"
+﻿#include <math.h>
+#include "tkc/mem.h"
+#include "tkc/str.h"
+#include "tkc/mutex.h"
+#include "tkc/platform.h"
+#include "tkc/time_now.h"
+#include "base/canvas.h"
+#include "base/window.h"
+#include "base/idle.h"
+#include "base/timer.h"
+#include "base/font_manager.h"
+#include "widgets/view.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "progress_polygon/polygon_pool.h"
+#include "progress_polygon/polygon_worker.h"
+#include "progress_polygon/progress_polygon.h"
+#include "progress_polygon/progress_polygon_group.h"
 #include "gtest/gtest.h"
 
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif /*M_PI*/
+
+static ret_t resolve_polygon(polygon_geometry_t* geo, const char* polygon, wh_t w, wh_t h) {
+  ret_t ret = RET_OK;
+  polygon_stations_t stations;
+
+  polygon_geometry_init(geo);
+  ret = polygon_stations_init(&stations, polygon);
+  if (ret == RET_OK) {
+    ret = polygon_geometry_resolve(geo, &stations, w, h);
+  }
+  polygon_stations_deinit(&stations);
+
+  return ret;
+}
+
+static char* make_arc_polygon(uint32_t n, float r1, float r2) {
+  uint32_t i = 0;
+  str_t str;
+
+  str_init(&str, n * 40);
+  for (i = 0; i < n; i++) {
+    double v = (double)i / (n - 1);
+    double a = v * M_PI;
+    str_append_format(&str, 128, "(%f,%f,%f,%f,%f)", v, 200 + r1 * cos(a), 200 - r1 * sin(a),
+                      200 + r2 * cos(a), 200 - r2 * sin(a));
+  }
+
+  return str.str;
+}
+
 TEST(progress_polygon, parse0) {
-  polygon_points_t points;
+  polygon_stations_t stations;
   const char* data = "()";
-  ret_t ret = polygon_points_init(&points, data);
+  ret_t ret = polygon_stations_init(&stations, data);
   EXPECT_EQ(ret, RET_OK);
-  EXPECT_EQ(points.size, 1);
-  EXPECT_EQ(points.capacity, 1);
-  EXPECT_EQ(points.points[0].value, 0);
-  EXPECT_EQ(points.points[0].x1, 0);
-  EXPECT_EQ(points.points[0].y1, 0);
-  EXPECT_EQ(points.points[0].x2, 0);
-  EXPECT_EQ(points.points[0].y2, 0);
+  EXPECT_EQ(stations.size, 1);
+  EXPECT_EQ(POLYGON_STATIONS_VALUES(&stations)[0], 0);
+  EXPECT_EQ(POLYGON_STATIONS_X1(&stations)[0], 0);
+  EXPECT_EQ(POLYGON_STATIONS_Y1(&stations)[0], 0);
+  EXPECT_EQ(POLYGON_STATIONS_X2(&stations)[0], 0);
+  EXPECT_EQ(POLYGON_STATIONS_Y2(&stations)[0], 0);
 
-  polygon_points_deinit(&points);
+  polygon_stations_deinit(&stations);
 }
 
 TEST(progress_polygon, parse1) {
-  polygon_points_t points;
+  polygon_stations_t stations;
   const char* data = "(0,1,2,3,4)";
-  ret_t ret = polygon_points_init(&points, data);
+  ret_t ret = polygon_stations_init(&stations, data);
   EXPECT_EQ(ret, RET_OK);
-  EXPECT_EQ(points.size, 1);
-  EXPECT_EQ(points.capacity, 1);
-  EXPECT_EQ(points.points[0].value, 0);
-  EXPECT_EQ(points.points[0].x1, 1);
-  EXPECT_EQ(points.points[0].y1, 2);
-  EXPECT_EQ(points.points[0].x2, 3);
-  EXPECT_EQ(points.points[0].y2, 4);
+  EXPECT_EQ(stations.size, 1);
+  EXPECT_EQ(POLYGON_STATIONS_VALUES(&stations)[0], 0);
+  EXPECT_EQ(POLYGON_STATIONS_X1(&stations)[0], 1);
+  EXPECT_EQ(POLYGON_STATIONS_Y1(&stations)[0], 2);
+  EXPECT_EQ(POLYGON_STATIONS_X2(&stations)[0], 3);
+  EXPECT_EQ(POLYGON_STATIONS_Y2(&stations)[0], 4);
 
-  polygon_points_deinit(&points);
+  polygon_stations_deinit(&stations);
 }
 
 TEST(progress_polygon, parse2) {
-  polygon_points_t points;
+  polygon_stations_t stations;
   const char* data = "(0 , 1 , 2 , 3 , 4)";
-  ret_t ret = polygon_points_init(&points, data);
+  ret_t ret = polygon_stations_init(&stations, data);
   EXPECT_EQ(ret, RET_OK);
-  EXPECT_EQ(points.size, 1);
-  EXPECT_EQ(points.capacity, 1);
-  EXPECT_EQ(points.points[0].value, 0);
-  EXPECT_EQ(points.points[0].x1, 1);
-  EXPECT_EQ(points.points[0].y1, 2);
-  EXPECT_EQ(points.points[0].x2, 3);
-  EXPECT_EQ(points.points[0].y2, 4);
+  EXPECT_EQ(stations.size, 1);
+  EXPECT_EQ(POLYGON_STATIONS_VALUES(&stations)[0], 0);
+  EXPECT_EQ(POLYGON_STATIONS_X1(&stations)[0], 1);
+  EXPECT_EQ(POLYGON_STATIONS_Y1(&stations)[0], 2);
+  EXPECT_EQ(POLYGON_STATIONS_X2(&stations)[0], 3);
+  EXPECT_EQ(POLYGON_STATIONS_Y2(&stations)[0], 4);
 
-  polygon_points_deinit(&points);
+  polygon_stations_deinit(&stations);
 }
 
 TEST(progress_polygon, parse3) {
-  polygon_points_t points;
+  polygon_stations_t stations;
   const char* data = "(0 , 1 , 2 , 3 , 4), (0.5 , 1.1 , 2.2 , 3.3 , 4.4)";
-  ret_t ret = polygon_points_init(&points, data);
+  ret_t ret = polygon_stations_init(&stations, data);
   EXPECT_EQ(ret, RET_OK);
-  EXPECT_EQ(points.size, 2);
-  EXPECT_EQ(points.capacity, 2);
-  EXPECT_EQ(points.points[0].value, 0);
-  EXPECT_EQ(points.points[0].x1, 1);
-  EXPECT_EQ(points.points[0].y1, 2);
-  EXPECT_EQ(points.points[0].x2, 3);
-  EXPECT_EQ(points.points[0].y2, 4);
+  EXPECT_EQ(stations.size, 2);
+  EXPECT_EQ(POLYGON_STATIONS_VALUES(&stations)[0], 0);
+  EXPECT_EQ(POLYGON_STATIONS_X1(&stations)[0], 1);
+  EXPECT_EQ(POLYGON_STATIONS_Y1(&stations)[0], 2);
+  EXPECT_EQ(POLYGON_STATIONS_X2(&stations)[0], 3);
+  EXPECT_EQ(POLYGON_STATIONS_Y2(&stations)[0], 4);
 
-   EXPECT_EQ(points.capacity, 2);
-  EXPECT_EQ(tk_fequal(points.points[1].value, 0.5), TRUE);
-  EXPECT_EQ(tk_fequal(points.points[1].x1, 1.1), TRUE);
-  EXPECT_EQ(tk_fequal(points.points[1].y1, 2.2), TRUE);
-  EXPECT_EQ(tk_fequal(points.points[1].x2, 3.3), TRUE);
-  EXPECT_EQ(tk_fequal(points.points[1].y2, 4.4), TRUE);
+  EXPECT_EQ(tk_fequal(POLYGON_STATIONS_VALUES(&stations)[1], 0.5), TRUE);
+  EXPECT_EQ(tk_fequal(POLYGON_STATIONS_X1(&stations)[1], 1.1), TRUE);
+  EXPECT_EQ(tk_fequal(POLYGON_STATIONS_Y1(&stations)[1], 2.2), TRUE);
+  EXPECT_EQ(tk_fequal(POLYGON_STATIONS_X2(&stations)[1], 3.3), TRUE);
+  EXPECT_EQ(tk_fequal(POLYGON_STATIONS_Y2(&stations)[1], 4.4), TRUE);
 
-  polygon_points_deinit(&points);
+  polygon_stations_deinit(&stations);
 }
 
 TEST(progress_polygon, basic) {
@@ -77,3 +121,1261 @@ TEST(progress_polygon, basic) {
 
   widget_destroy(w);
 }
+
+TEST(progress_polygon, lazy) {
+  widget_t* w = progress_polygon_create(NULL, 10, 20, 100, 40);
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(w);
+
+  progress_polygon_set_polygon(w, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  EXPECT_EQ(progress_polygon->stations.size, 0);
+  EXPECT_EQ(progress_polygon->geometry.size, 0);
+
+  /*保留了字符串，几何数据准备好后不再保存点数据*/
+  EXPECT_EQ(progress_polygon_prewarm(w), RET_OK);
+  EXPECT_EQ(progress_polygon->stations.size, 0);
+  EXPECT_EQ(progress_polygon->geometry.size, 2);
+  EXPECT_EQ(progress_polygon->geometry.w, 100);
+  EXPECT_EQ(progress_polygon->geometry.h, 40);
+  EXPECT_EQ(progress_polygon->geometry.x1[1], 100);
+  EXPECT_EQ(progress_polygon->geometry.y2[1], 40);
+
+  progress_polygon_set_polygon(w, "(0, 0,0,0,1)(0.5, 0.5,0,0.5,1)(1, 1,0,1,1)");
+  EXPECT_EQ(progress_polygon->geometry.size, 2);
+  EXPECT_EQ(progress_polygon_prewarm(w), RET_OK);
+  EXPECT_EQ(progress_polygon->geometry.size, 3);
+  EXPECT_EQ(progress_polygon->geometry.x1[1], 50);
+
+  /*大小变化后重新解析*/
+  widget_resize(w, 200, 40);
+  EXPECT_EQ(progress_polygon_prewarm(w), RET_OK);
+  EXPECT_EQ(progress_polygon->stations.size, 0);
+  EXPECT_EQ(progress_polygon->geometry.x1[1], 100);
+
+  widget_destroy(w);
+}
+
+TEST(progress_polygon, prewarm_all) {
+  uint32_t i = 0;
+  uint32_t idles = idle_count();
+  widget_t* root = view_create(NULL, 0, 0, 400, 300);
+  widget_t* good = progress_polygon_create(root, 0, 0, 100, 40);
+  widget_t* bad = progress_polygon_create(root, 0, 50, 100, 40);
+  widget_t* empty_range = progress_polygon_create(root, 0, 200, 100, 40);
+
+  /*无法准备好的控件: 没有多边形、无法解析、大小为 0 和范围无效*/
+  progress_polygon_set_polygon(good, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  progress_polygon_set_polygon(bad, "bad");
+  for (i = 0; i < 4; i++) {
+    progress_polygon_create(root, 0, 100, 100, 40);
+  }
+  progress_polygon_set_polygon(progress_polygon_create(root, 0, 150, 0, 0),
+                               "(0, 0,0,0,1)(1, 1,0,1,1)");
+  progress_polygon_set_polygon(empty_range, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  progress_polygon_set_max(empty_range, 0);
+
+  EXPECT_EQ(progress_polygon_prewarm_all(root), RET_OK);
+  EXPECT_EQ(idle_count(), idles + 1);
+
+  /*每个控件只尝试一次，全部尝试过后删除 idle*/
+  for (i = 0; i < 8 && idle_count() > idles; i++) {
+    idle_dispatch();
+  }
+  EXPECT_EQ(idle_count(), idles);
+  polygon_worker_flush();
+  EXPECT_EQ(PROGRESS_POLYGON(good)->geometry.size, 2);
+  EXPECT_EQ(PROGRESS_POLYGON(bad)->geometry.size, 0);
+
+  widget_destroy(root);
+}
+
+TEST(progress_polygon, boundary) {
+  uint32_t offset = 0;
+  polygon_geometry_t geo;
+  polygon_point_t boundary;
+
+  ASSERT_EQ(resolve_polygon(&geo, "(0, 0,0,0,1)(0.5, 0.5,0,0.5,1)(1, 1,0,1,1)", 200, 10), RET_OK);
+
+  EXPECT_EQ(polygon_geometry_get_boundary(&geo, 0, &offset, &boundary), RET_OK);
+  EXPECT_EQ(offset, 0);
+  EXPECT_EQ(boundary.x1, 0);
+
+  EXPECT_EQ(polygon_geometry_get_boundary(&geo, 0.25, &offset, &boundary), RET_OK);
+  EXPECT_EQ(offset, 1);
+  EXPECT_EQ(boundary.x1, 50);
+  EXPECT_EQ(boundary.y2, 10);
+
+  EXPECT_EQ(polygon_geometry_get_boundary(&geo, 0.5, &offset, &boundary), RET_OK);
+  EXPECT_EQ(offset, 1);
+  EXPECT_EQ(boundary.x1, 100);
+
+  EXPECT_EQ(polygon_geometry_get_boundary(&geo, 1, &offset, &boundary), RET_OK);
+  EXPECT_EQ(offset, 2);
+  EXPECT_EQ(boundary.x2, 200);
+
+  polygon_geometry_deinit(&geo);
+}
+
+TEST(progress_polygon, value_at) {
+  double value = 0;
+  widget_t* w = progress_polygon_create(NULL, 10, 20, 100, 40);
+
+  progress_polygon_set_polygon(w, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  EXPECT_EQ(progress_polygon_get_value_at(w, 25, 20, &value), RET_OK);
+  EXPECT_NEAR(value, 25, 0.01);
+  EXPECT_EQ(progress_polygon_get_value_at(w, 100, 0, &value), RET_OK);
+  EXPECT_NEAR(value, 100, 0.01);
+
+  progress_polygon_set_polygon(w, "(0, 0,1,0,1)(1, 1,0,1,1)");
+  EXPECT_EQ(progress_polygon_get_value_at(w, 50, 30, &value), RET_OK);
+  EXPECT_NEAR(value, 50, 0.01);
+  EXPECT_EQ(progress_polygon_get_value_at(w, 50, 5, &value), RET_NOT_FOUND);
+
+  widget_destroy(w);
+}
+
+typedef struct _value_events_t {
+  uint32_t changing;
+  uint32_t changed;
+  double old_value;
+  double new_value;
+} value_events_t;
+
+static ret_t on_value_event(void* ctx, event_t* e) {
+  value_events_t* events = (value_events_t*)ctx;
+  value_change_event_t* evt = value_change_event_cast(e);
+
+  if (e->type == EVT_VALUE_CHANGING) {
+    events->changing++;
+  } else {
+    events->changed++;
+  }
+  events->old_value = value_double(&(evt->old_value));
+  events->new_value = value_double(&(evt->new_value));
+
+  return RET_OK;
+}
+
+static ret_t dispatch_pointer(widget_t* widget, uint32_t type, xy_t x, xy_t y) {
+  pointer_event_t evt;
+
+  return widget_dispatch(widget, pointer_event_init(&evt, type, widget, x, y));
+}
+
+TEST(progress_polygon, drag) {
+  value_events_t events;
+  widget_t* view = view_create(NULL, 0, 0, 400, 300);
+  widget_t* w = progress_polygon_create(view, 10, 20, 100, 40);
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(w);
+
+  memset(&events, 0x00, sizeof(events));
+  progress_polygon_set_polygon(w, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  widget_on(w, EVT_VALUE_CHANGING, on_value_event, &events);
+  widget_on(w, EVT_VALUE_CHANGED, on_value_event, &events);
+
+  /*不可编辑时忽略指针事件*/
+  dispatch_pointer(w, EVT_POINTER_DOWN, 35, 40);
+  dispatch_pointer(w, EVT_POINTER_UP, 35, 40);
+  EXPECT_EQ(progress_polygon->value, 0);
+  EXPECT_EQ(events.changing + events.changed, 0);
+
+  progress_polygon_set_editable(w, TRUE);
+  dispatch_pointer(w, EVT_POINTER_DOWN, 35, 40);
+  EXPECT_NEAR(progress_polygon->value, 25, 0.01);
+  EXPECT_EQ(events.changing, 1);
+  EXPECT_EQ(events.changed, 0);
+
+  dispatch_pointer(w, EVT_POINTER_MOVE, 85, 40);
+  EXPECT_NEAR(progress_polygon->value, 75, 0.01);
+  EXPECT_EQ(events.changing, 2);
+  EXPECT_NEAR(events.new_value, 75, 0.01);
+
+  dispatch_pointer(w, EVT_POINTER_UP, 85, 40);
+  EXPECT_EQ(events.changed, 1);
+  EXPECT_EQ(events.old_value, 0);
+  EXPECT_NEAR(events.new_value, 75, 0.01);
+
+  /*松开后移动不再修改值*/
+  dispatch_pointer(w, EVT_POINTER_MOVE, 35, 40);
+  EXPECT_NEAR(progress_polygon->value, 75, 0.01);
+  EXPECT_EQ(events.changing, 2);
+
+  /*取消拖动时恢复拖动前的值，并且不触发 EVT_VALUE_CHANGED*/
+  dispatch_pointer(w, EVT_POINTER_DOWN, 60, 40);
+  dispatch_pointer(w, EVT_POINTER_MOVE, 100, 40);
+  EXPECT_NEAR(progress_polygon->value, 90, 0.01);
+  dispatch_pointer(w, EVT_POINTER_DOWN_ABORT, 100, 40);
+  EXPECT_NEAR(progress_polygon->value, 75, 0.01);
+  EXPECT_EQ(events.changing, 5);
+  EXPECT_NEAR(events.new_value, 75, 0.01);
+  EXPECT_EQ(events.changed, 1);
+  EXPECT_FALSE(progress_polygon->dragging);
+
+  widget_destroy(view);
+}
+
+TEST(progress_polygon, hit_grid_arc) {
+  uint32_t i = 0;
+  uint32_t max_cell = 0;
+  char* polygon = make_arc_polygon(2000, 100, 150);
+  polygon_geometry_t geo;
+  polygon_hit_grid_t grid;
+
+  polygon_hit_grid_init(&grid);
+  ASSERT_EQ(resolve_polygon(&geo, polygon, 400, 400), RET_OK);
+  ASSERT_EQ(polygon_hit_grid_build(&grid, &geo), RET_OK);
+
+  for (i = 0; i < grid.cols * grid.rows; i++) {
+    max_cell = tk_max(max_cell, grid.cells[i + 1] - grid.cells[i]);
+  }
+  /*每个单元中的四边形个数与点的总数无关*/
+  EXPECT_LT(max_cell, 64);
+
+  for (i = 0; i < 100; i++) {
+    float progress = -1;
+    double expected = (i + 0.5) / 100;
+    double a = expected * M_PI;
+    float x = 200 + 125 * cos(a);
+    float y = 200 - 125 * sin(a);
+    EXPECT_EQ(polygon_hit_grid_query(&grid, &geo, x, y, 0, &progress), RET_OK);
+    EXPECT_NEAR(progress, expected, 0.001);
+  }
+
+  {
+    float progress = -1;
+    EXPECT_EQ(polygon_hit_grid_query(&grid, &geo, 200, 200, 0, &progress), RET_NOT_FOUND);
+  }
+
+  polygon_hit_grid_deinit(&grid);
+  polygon_geometry_deinit(&geo);
+  TKMEM_FREE(polygon);
+}
+
+TEST(progress_polygon, morph) {
+  polygon_geometry_t from;
+  polygon_geometry_t to;
+  polygon_geometry_t out;
+  polygon_morph_t morph;
+
+  polygon_geometry_init(&out);
+  ASSERT_EQ(resolve_polygon(&from, "(0, 0,0,0,1)(1, 1,0,1,1)", 100, 10), RET_OK);
+  ASSERT_EQ(resolve_polygon(&to, "(0, 0,0,0,1)(0.5, 0.5,0.2,0.5,0.8)(1, 1,0,1,1)", 100, 10),
+            RET_OK);
+  ASSERT_EQ(polygon_morph_init(&morph, &from, &to), RET_OK);
+  EXPECT_EQ(morph.size, 3);
+
+  EXPECT_EQ(polygon_morph_step(&morph, 0, &out), RET_OK);
+  EXPECT_EQ(out.size, 3);
+  EXPECT_EQ(out.x1[1], 50);
+  EXPECT_EQ(out.y1[1], 0);
+  EXPECT_EQ(out.y2[1], 10);
+
+  EXPECT_EQ(polygon_morph_step(&morph, 0.5, &out), RET_OK);
+  EXPECT_EQ(out.values[1], 0.5);
+  EXPECT_NEAR(out.y1[1], 1, 0.001);
+  EXPECT_NEAR(out.y2[1], 9, 0.001);
+
+  EXPECT_EQ(polygon_morph_step(&morph, 1, &out), RET_OK);
+  EXPECT_NEAR(out.y1[1], 2, 0.001);
+  EXPECT_NEAR(out.y2[1], 8, 0.001);
+
+  polygon_morph_deinit(&morph);
+  polygon_geometry_deinit(&out);
+  polygon_geometry_deinit(&to);
+  polygon_geometry_deinit(&from);
+}
+
+TEST(progress_polygon, morph_duplicated_value) {
+  polygon_geometry_t from;
+  polygon_geometry_t to;
+  polygon_morph_t morph;
+
+  ASSERT_EQ(resolve_polygon(&from, "(0, 0,0.25,0,0.75)(0, 0.5,0.25,0.5,0.75)(1, 1,0,1,1)", 100, 10),
+            RET_OK);
+  ASSERT_EQ(resolve_polygon(&to, "(0, 0,0,0,1)(1, 1,0,1,1)", 100, 10), RET_OK);
+  ASSERT_EQ(polygon_morph_init(&morph, &from, &to), RET_OK);
+  EXPECT_EQ(morph.size, 3);
+
+  polygon_morph_deinit(&morph);
+  polygon_geometry_deinit(&to);
+  polygon_geometry_deinit(&from);
+}
+
+TEST(progress_polygon, morph_widget) {
+  uint32_t mem_size = 0;
+  uint32_t morph_size = 0;
+  widget_t* w = progress_polygon_create(NULL, 10, 20, 100, 40);
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(w);
+
+  /*还没有形状时直接设置*/
+  EXPECT_EQ(progress_polygon_morph_to(w, "(0, 0,0,0,1)(1, 1,0,1,1)", 500), RET_OK);
+  EXPECT_STREQ(progress_polygon->polygon, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  EXPECT_EQ(progress_polygon->morphing == NULL, TRUE);
+
+  EXPECT_EQ(progress_polygon_morph_to(w, "(0, 0,1,0,1)(1, 1,0,1,1)", 500), RET_OK);
+  ASSERT_EQ(progress_polygon->morphing != NULL, TRUE);
+  EXPECT_STREQ(progress_polygon->morphing->target, "(0, 0,1,0,1)(1, 1,0,1,1)");
+  EXPECT_EQ(progress_polygon->morphing->morph.size, 2);
+  EXPECT_NE(progress_polygon->morphing->timer_id, TK_INVALID_ID);
+
+  /*直接设置形状会取消变形，并释放变形的状态*/
+  progress_polygon_set_polygon(w, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  EXPECT_EQ(progress_polygon->morphing == NULL, TRUE);
+
+  /*无法解析的目标形状返回错误，当前形状不变*/
+  EXPECT_EQ(progress_polygon_morph_to(w, NULL, 500), RET_BAD_PARAMS);
+  EXPECT_EQ(widget_set_prop_str(w, PROGRESS_POLYGON_PROP_MORPH_TO, "bad"), RET_BAD_PARAMS);
+  EXPECT_EQ(progress_polygon->morphing == NULL, TRUE);
+  EXPECT_STREQ(progress_polygon->polygon, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  EXPECT_EQ(widget_set_prop_str(w, PROGRESS_POLYGON_PROP_MORPH_TO, "(0, 0,1,0,1)(1, 1,0,1,1)"),
+            RET_OK);
+  ASSERT_EQ(progress_polygon->morphing != NULL, TRUE);
+  EXPECT_STREQ(progress_polygon->morphing->target, "(0, 0,1,0,1)(1, 1,0,1,1)");
+
+  /*变形的状态(包括目标形状和插值用的数据)计入内存*/
+  mem_size = progress_polygon_get_mem_size(w);
+  morph_size = sizeof(progress_polygon_morphing_t) + strlen(progress_polygon->morphing->target) +
+               1 + polygon_morph_get_mem_size(&progress_polygon->morphing->morph);
+  EXPECT_EQ(polygon_morph_get_mem_size(&progress_polygon->morphing->morph), 2 * 5 * 2 * 4);
+  EXPECT_STREQ(progress_polygon->polygon, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  progress_polygon_set_polygon(w, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  EXPECT_EQ(progress_polygon_get_mem_size(w), mem_size - morph_size);
+
+  widget_destroy(w);
+}
+
+TEST(progress_polygon, morph_finish) {
+  polygon_geometry_t expected;
+  char* from_polygon = make_arc_polygon(1000, 100, 150);
+  char* to_polygon = make_arc_polygon(800, 80, 160);
+  widget_t* w = progress_polygon_create(NULL, 0, 0, 400, 400);
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(w);
+
+  progress_polygon_set_polygon(w, from_polygon);
+  EXPECT_EQ(progress_polygon_prewarm(w), RET_OK);
+  polygon_worker_flush();
+  EXPECT_EQ(progress_polygon->geometry.size, 1000);
+
+  EXPECT_EQ(progress_polygon_morph_to(w, to_polygon, 20), RET_OK);
+  ASSERT_EQ(progress_polygon->morphing != NULL, TRUE);
+  sleep_ms(50);
+  timer_dispatch();
+
+  /*结束时直接得到准确的目标形状，不会先换成简化的形状再等后台任务*/
+  EXPECT_EQ(progress_polygon->morphing == NULL, TRUE);
+  EXPECT_EQ(progress_polygon->prepare_job == NULL, TRUE);
+  EXPECT_EQ(polygon_worker_get_pending(), 0);
+  ASSERT_EQ(resolve_polygon(&expected, to_polygon, 400, 400), RET_OK);
+  ASSERT_EQ(progress_polygon->geometry.size, expected.size);
+  EXPECT_EQ(memcmp(progress_polygon->geometry.values, expected.values,
+                   expected.size * 5 * sizeof(float)),
+            0);
+  EXPECT_STREQ(progress_polygon->polygon, to_polygon);
+
+  polygon_geometry_deinit(&expected);
+  widget_destroy(w);
+  TKMEM_FREE(from_polygon);
+  TKMEM_FREE(to_polygon);
+}
+
+TEST(progress_polygon, morph_frame_cost) {
+  uint32_t i = 0;
+  uint32_t frames = 1000;
+  uint64_t start = 0;
+  uint64_t cost = 0;
+  char* from_polygon = make_arc_polygon(1000, 100, 150);
+  char* to_polygon = make_arc_polygon(800, 80, 160);
+  polygon_geometry_t from;
+  polygon_geometry_t to;
+  polygon_geometry_t out;
+  polygon_morph_t morph;
+  mem_stat_t stat;
+
+  polygon_geometry_init(&out);
+  ASSERT_EQ(resolve_polygon(&from, from_polygon, 400, 400), RET_OK);
+  ASSERT_EQ(resolve_polygon(&to, to_polygon, 400, 400), RET_OK);
+  ASSERT_EQ(polygon_morph_init(&morph, &from, &to), RET_OK);
+  polygon_morph_step(&morph, 0, &out);
+
+  /*每一帧只做插值，不分配内存*/
+  stat = tk_mem_stat();
+  start = time_now_us();
+  for (i = 0; i < frames; i++) {
+    polygon_morph_step(&morph, (float)i / frames, &out);
+  }
+  cost = time_now_us() - start;
+  EXPECT_EQ(tk_mem_stat().used_block_nr, stat.used_block_nr);
+  EXPECT_EQ(out.size, morph.size);
+  RecordProperty("stations", morph.size);
+  RecordProperty("ns_per_frame", (int)(cost * 1000 / frames));
+
+  /*两端分别是起始形状和目标形状*/
+  polygon_morph_step(&morph, 0, &out);
+  EXPECT_EQ(out.x1[0], from.x1[0]);
+  EXPECT_EQ(out.y2[out.size - 1], from.y2[from.size - 1]);
+  polygon_morph_step(&morph, 1, &out);
+  EXPECT_NEAR(out.x1[0], to.x1[0], 0.001);
+  EXPECT_NEAR(out.y2[out.size - 1], to.y2[to.size - 1], 0.001);
+
+  polygon_morph_deinit(&morph);
+  polygon_geometry_deinit(&out);
+  polygon_geometry_deinit(&to);
+  polygon_geometry_deinit(&from);
+  TKMEM_FREE(from_polygon);
+  TKMEM_FREE(to_polygon);
+}
+
+TEST(progress_polygon, stations) {
+  str_t str;
+  polygon_stations_t stations;
+
+  ASSERT_EQ(polygon_stations_init(&stations, "(0 , 1 , 2 , 3 , 4), (0.5 , 1.5 , 2.5 , 3.5 , 4.5)"),
+            RET_OK);
+  EXPECT_EQ(stations.size, 2);
+  EXPECT_EQ(POLYGON_STATIONS_VALUES(&stations)[1], 0.5);
+  EXPECT_EQ(POLYGON_STATIONS_X1(&stations)[0], 1);
+  EXPECT_EQ(POLYGON_STATIONS_Y1(&stations)[1], 2.5);
+  EXPECT_EQ(POLYGON_STATIONS_X2(&stations)[0], 3);
+  EXPECT_EQ(POLYGON_STATIONS_Y2(&stations)[1], 4.5);
+
+  str_init(&str, 0);
+  EXPECT_EQ(polygon_stations_to_str(&stations, &str), RET_OK);
+  EXPECT_STREQ(str.str, "(0,1,2,3,4)(0.5,1.5,2.5,3.5,4.5)");
+  polygon_stations_deinit(&stations);
+
+  /*格式错误时停止解析，后面的点被丢掉，每一列都移到正确的位置*/
+  ASSERT_EQ(polygon_stations_init(&stations, "(0,1,2,3,4)(0.5,1.5,2.5,3.5,4.5)(1,5)("), RET_OK);
+  EXPECT_EQ(stations.size, 3);
+  EXPECT_EQ(POLYGON_STATIONS_X1(&stations)[0], 1);
+  EXPECT_EQ(POLYGON_STATIONS_Y2(&stations)[0], 4);
+  EXPECT_EQ(POLYGON_STATIONS_VALUES(&stations)[1], 0.5);
+  EXPECT_EQ(POLYGON_STATIONS_Y1(&stations)[1], 2.5);
+  EXPECT_EQ(POLYGON_STATIONS_Y2(&stations)[1], 4.5);
+  EXPECT_EQ(POLYGON_STATIONS_VALUES(&stations)[2], 1);
+  EXPECT_EQ(POLYGON_STATIONS_X1(&stations)[2], 5);
+  EXPECT_EQ(POLYGON_STATIONS_Y1(&stations)[2], 0);
+  EXPECT_EQ(POLYGON_STATIONS_Y2(&stations)[2], 0);
+  EXPECT_EQ(polygon_stations_get_mem_size(&stations),
+            polygon_pool_block_size(3 * 5 * sizeof(float)));
+  polygon_stations_deinit(&stations);
+
+  ASSERT_EQ(polygon_stations_init(&stations, "no tuples"), RET_OK);
+  EXPECT_EQ(stations.size, 0);
+  EXPECT_EQ(stations.data == NULL, TRUE);
+
+  str_reset(&str);
+}
+
+TEST(progress_polygon, keep_polygon) {
+  value_t v;
+  widget_t* w = progress_polygon_create(NULL, 10, 20, 100, 40);
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(w);
+
+  progress_polygon_set_keep_polygon(w, FALSE);
+  progress_polygon_set_polygon(w, "(0, 0, 0, 0, 1) (1, 1, 0, 1, 1)");
+  EXPECT_EQ(progress_polygon->polygon != NULL, TRUE);
+
+  EXPECT_EQ(progress_polygon_prewarm(w), RET_OK);
+  EXPECT_EQ(progress_polygon->polygon == NULL, TRUE);
+  EXPECT_EQ(progress_polygon->stations.size, 2);
+
+  EXPECT_EQ(widget_get_prop(w, PROGRESS_POLYGON_PROP_POLYGON, &v), RET_OK);
+  EXPECT_STREQ(value_str(&v), "(0,0,0,0,1)(1,1,0,1,1)");
+
+  widget_destroy(w);
+}
+
+/*原来的实现：value/min/max、polygon 字符串(一直保留)和点数组(size/capacity/points)，每个点 24 字节*/
+static uint32_t baseline_mem_size(uint32_t n, const char* polygon) {
+  uint32_t point_size = sizeof(double) + 4 * sizeof(float);
+  uint32_t points_size = 2 * sizeof(uint32_t) + sizeof(void*);
+
+  return 3 * sizeof(double) + sizeof(char*) + points_size + n * point_size + strlen(polygon) + 1;
+}
+
+TEST(progress_polygon, mem_size) {
+  uint32_t i = 0;
+  uint32_t n = 100;
+  uint32_t keep = 0;
+  uint32_t drop = 0;
+  uint32_t block = polygon_pool_block_size(5 * 5 * sizeof(float));
+  uint32_t fixed = sizeof(progress_polygon_t) - sizeof(widget_t);
+  widget_t* widgets[100];
+  polygon_pool_stat_t stat;
+  const char* polygon =
+      "(0,0,0.5,0,1)(0.7,0.9,0.5,0.9,1)(0.8,0.9,0.5,1,1)(0.9,0.9,0.5,1,0.5)(1,0.9,0,1,0)";
+
+  for (i = 0; i < n; i++) {
+    widgets[i] = progress_polygon_create(NULL, 0, 0, 100, 40);
+    progress_polygon_set_keep_polygon(widgets[i], (i % 2) == 0);
+    progress_polygon_set_polygon(widgets[i], polygon);
+    progress_polygon_prewarm(widgets[i]);
+  }
+
+  keep = progress_polygon_get_mem_size(widgets[0]);
+  drop = progress_polygon_get_mem_size(widgets[1]);
+  polygon_pool_get_stat(&stat);
+  RecordProperty("keep_polygon_bytes", keep);
+  RecordProperty("drop_polygon_bytes", drop);
+  RecordProperty("baseline_bytes", baseline_mem_size(5, polygon));
+
+  /*保留字符串时只保存几何数据，否则保存点数据和几何数据*/
+  EXPECT_EQ(keep, fixed + strlen(polygon) + 1 + block);
+  EXPECT_EQ(drop, fixed + 2 * block);
+  EXPECT_GE(stat.used, (n + n / 2) * block);
+
+  for (i = 0; i < n; i++) {
+    widget_destroy(widgets[i]);
+  }
+}
+
+TEST(progress_polygon, mem_size_baseline) {
+  uint32_t i = 0;
+  uint32_t nr[] = {64, 256, 1000};
+
+  /*点数较多时每个点的开销起主要作用，两种方式都要比原来的实现少*/
+  for (i = 0; i < ARRAY_SIZE(nr); i++) {
+    char* polygon = make_arc_polygon(nr[i], 100, 150);
+    uint32_t baseline = baseline_mem_size(nr[i], polygon);
+    widget_t* keep = progress_polygon_create(NULL, 0, 0, 400, 400);
+    widget_t* drop = progress_polygon_create(NULL, 0, 0, 400, 400);
+
+    progress_polygon_set_polygon(keep, polygon);
+    progress_polygon_set_keep_polygon(drop, FALSE);
+    progress_polygon_set_polygon(drop, polygon);
+    ASSERT_EQ(progress_polygon_prewarm(keep), RET_OK);
+    ASSERT_EQ(progress_polygon_prewarm(drop), RET_OK);
+    polygon_worker_flush();
+
+    EXPECT_LT(progress_polygon_get_mem_size(keep), baseline);
+    EXPECT_LT(progress_polygon_get_mem_size(drop), baseline);
+
+    widget_destroy(keep);
+    widget_destroy(drop);
+    TKMEM_FREE(polygon);
+  }
+}
+
+TEST(progress_polygon, polygon_round_trip) {
+  value_t v;
+  char* text = NULL;
+  uint32_t mem_size = 0;
+  float* data = TKMEM_ZALLOCN(float, 64 * 5);
+  char* polygon = make_arc_polygon(64, 100, 150);
+  widget_t* w = progress_polygon_create(NULL, 0, 0, 400, 400);
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(w);
+
+  progress_polygon_set_keep_polygon(w, FALSE);
+  progress_polygon_set_polygon(w, polygon);
+  ASSERT_EQ(progress_polygon_prewarm(w), RET_OK);
+  ASSERT_EQ(progress_polygon->stations.size, 64);
+  memcpy(data, progress_polygon->stations.data, 64 * 5 * sizeof(float));
+  mem_size = progress_polygon_get_mem_size(w);
+
+  /*读取时临时生成字符串，下次 prepare 时释放*/
+  ASSERT_EQ(widget_get_prop(w, PROGRESS_POLYGON_PROP_POLYGON, &v), RET_OK);
+  text = tk_strdup(value_str(&v));
+  EXPECT_GT(progress_polygon_get_mem_size(w), mem_size);
+  ASSERT_EQ(progress_polygon_prewarm(w), RET_OK);
+  EXPECT_EQ(progress_polygon->polygon, (char*)NULL);
+  EXPECT_EQ(progress_polygon_get_mem_size(w), mem_size);
+
+  /*重新生成的字符串解析后得到完全相同的点*/
+  progress_polygon_set_polygon(w, text);
+  ASSERT_EQ(progress_polygon_prewarm(w), RET_OK);
+  ASSERT_EQ(progress_polygon->stations.size, 64);
+  EXPECT_EQ(memcmp(data, progress_polygon->stations.data, 64 * 5 * sizeof(float)), 0);
+  EXPECT_EQ(progress_polygon->polygon, (char*)NULL);
+
+  widget_destroy(w);
+  TKMEM_FREE(text);
+  TKMEM_FREE(polygon);
+  TKMEM_FREE(data);
+}
+
+TEST(progress_polygon, gradient_parse) {
+  polygon_gradient_t gradient;
+
+  ASSERT_EQ(polygon_gradient_init(&gradient, "#ff0000;#00ff00;#0000ff"), RET_OK);
+  EXPECT_EQ(gradient.nr, 3);
+  EXPECT_EQ(gradient.stops[0], 0);
+  EXPECT_EQ(gradient.stops[1], 0.5);
+  EXPECT_EQ(gradient.stops[2], 1);
+  EXPECT_EQ(gradient.colors[1].rgba.g, 0xff);
+  polygon_gradient_deinit(&gradient);
+
+  ASSERT_EQ(polygon_gradient_init(&gradient, "0.2:#000000; 0.6:#ffffff"), RET_OK);
+  EXPECT_EQ(gradient.nr, 2);
+  EXPECT_NEAR(gradient.stops[0], 0.2, 0.0001);
+  EXPECT_NEAR(gradient.stops[1], 0.6, 0.0001);
+  EXPECT_EQ(polygon_gradient_get_color(&gradient, 0).rgba.r, 0);
+  EXPECT_NEAR(polygon_gradient_get_color(&gradient, 0.4).rgba.r, 0x80, 1);
+  EXPECT_EQ(polygon_gradient_get_color(&gradient, 1).rgba.r, 0xff);
+  polygon_gradient_deinit(&gradient);
+
+  EXPECT_NE(polygon_gradient_init(&gradient, " ; "), RET_OK);
+}
+
+TEST(progress_polygon, gradient_strips) {
+  polygon_geometry_t geo;
+  polygon_gradient_t gradient;
+
+  ASSERT_EQ(resolve_polygon(&geo, "(0, 0,0,0,1)(0.5, 0.5,0,0.5,1)(1, 1,0,1,1)", 100, 10), RET_OK);
+  ASSERT_EQ(polygon_gradient_init(&gradient, "0:#000000;0.25:#ffffff;0.5:#000000"), RET_OK);
+  EXPECT_EQ(polygon_gradient_has_strips(&gradient), FALSE);
+  ASSERT_EQ(polygon_gradient_build_strips(&gradient, &geo), RET_OK);
+  EXPECT_EQ(polygon_gradient_has_strips(&gradient), TRUE);
+
+  /*0.25 处插入了一个点，0 和 0.5 与已有的点重合*/
+  EXPECT_EQ(gradient.strips.size, 4);
+  EXPECT_EQ(gradient.strips.values[1], 0.25);
+  EXPECT_EQ(gradient.strips.x1[1], 25);
+  EXPECT_EQ(gradient.strips.y2[1], 10);
+  EXPECT_EQ(gradient.strip_colors[0].rgba.r, 0);
+  EXPECT_EQ(gradient.strip_colors[1].rgba.r, 0xff);
+  EXPECT_EQ(gradient.strip_colors[2].rgba.r, 0);
+  EXPECT_EQ(gradient.strip_colors[3].rgba.r, 0);
+
+  EXPECT_EQ(polygon_gradient_reset_strips(&gradient), RET_OK);
+  EXPECT_EQ(polygon_gradient_has_strips(&gradient), FALSE);
+
+  polygon_gradient_deinit(&gradient);
+  polygon_geometry_deinit(&geo);
+}
+
+TEST(progress_polygon, gradient_update_strips) {
+  float* values = NULL;
+  color_t* colors = NULL;
+  polygon_geometry_t geo;
+  polygon_geometry_t to;
+  polygon_morph_t morph;
+  polygon_gradient_t gradient;
+
+  ASSERT_EQ(resolve_polygon(&geo, "(0, 0,0,0,1)(0.5, 0.5,0,0.5,1)(1, 1,0,1,1)", 100, 10), RET_OK);
+  ASSERT_EQ(resolve_polygon(&to, "(0, 0,0.2,0,0.8)(1, 1,0.2,1,0.8)", 100, 10), RET_OK);
+  ASSERT_EQ(polygon_morph_init(&morph, &geo, &to), RET_OK);
+  ASSERT_EQ(polygon_gradient_init(&gradient, "0:#000000;0.25:#ffffff;0.5:#000000"), RET_OK);
+  ASSERT_EQ(polygon_morph_step(&morph, 0, &geo), RET_OK);
+  ASSERT_EQ(polygon_gradient_build_strips(&gradient, &geo), RET_OK);
+  values = gradient.strips.values;
+  colors = gradient.strip_colors;
+
+  /*变形的每一帧点数不变，条带在原来的内存中更新*/
+  ASSERT_EQ(polygon_morph_step(&morph, 0.5, &geo), RET_OK);
+  EXPECT_EQ(polygon_gradient_update_strips(&gradient, &geo), RET_OK);
+  EXPECT_EQ(gradient.strips.values, values);
+  EXPECT_EQ(gradient.strip_colors, colors);
+  EXPECT_EQ(gradient.strips.size, 4);
+  EXPECT_EQ(gradient.strips.x1[1], 25);
+  EXPECT_NEAR(gradient.strips.y1[1], 1, 0.001);
+  EXPECT_NEAR(gradient.strips.y2[1], 9, 0.001);
+  EXPECT_EQ(gradient.strip_colors[1].rgba.r, 0xff);
+
+  polygon_gradient_deinit(&gradient);
+  polygon_morph_deinit(&morph);
+  polygon_geometry_deinit(&to);
+  polygon_geometry_deinit(&geo);
+}
+
+static uint32_t gradient_count_runs(const polygon_gradient_t* gradient) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+
+  while (i + 1 < gradient->strips.size) {
+    i = polygon_gradient_get_run_end(gradient, i);
+    n++;
+  }
+
+  return n;
+}
+
+TEST(progress_polygon, gradient_runs) {
+  uint32_t i = 0;
+  str_t str;
+  char* arc = make_arc_polygon(64, 100, 150);
+  polygon_geometry_t geo;
+  polygon_gradient_t gradient;
+
+  str_init(&str, 0);
+  for (i = 0; i <= 100; i++) {
+    str_append_format(&str, 64, "(%f, %u,0,%u,1)", i / 100.0, i, i);
+  }
+
+  /*直线上同一个关键点区间内的条带合并成一段*/
+  ASSERT_EQ(resolve_polygon(&geo, str.str, 100, 10), RET_OK);
+  ASSERT_EQ(polygon_gradient_init(&gradient, "#000000;#ffffff;#000000"), RET_OK);
+  ASSERT_EQ(polygon_gradient_build_strips(&gradient, &geo), RET_OK);
+  EXPECT_EQ(gradient.strips.size, 101);
+  EXPECT_EQ(polygon_gradient_get_run_end(&gradient, 0), 50);
+  EXPECT_EQ(polygon_gradient_get_run_end(&gradient, 20), 50);
+  EXPECT_EQ(polygon_gradient_get_run_end(&gradient, 50), 100);
+  EXPECT_EQ(gradient_count_runs(&gradient), 2);
+  polygon_gradient_deinit(&gradient);
+  polygon_geometry_deinit(&geo);
+
+  /*半圆只有一个区间，转过的角度太大时分成两段*/
+  ASSERT_EQ(resolve_polygon(&geo, arc, 400, 400), RET_OK);
+  ASSERT_EQ(polygon_gradient_init(&gradient, "#000000;#ffffff"), RET_OK);
+  ASSERT_EQ(polygon_gradient_build_strips(&gradient, &geo), RET_OK);
+  EXPECT_EQ(gradient_count_runs(&gradient), 2);
+  polygon_gradient_deinit(&gradient);
+  polygon_geometry_deinit(&geo);
+
+  TKMEM_FREE(arc);
+  str_reset(&str);
+}
+
+TEST(progress_polygon, async_prepare) {
+  polygon_geometry_t expected;
+  char* polygon = make_arc_polygon(1000, 100, 150);
+  widget_t* w = progress_polygon_create(NULL, 0, 0, 400, 400);
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(w);
+
+  progress_polygon_set_polygon(w, polygon);
+  EXPECT_EQ(progress_polygon_prewarm(w), RET_OK);
+  EXPECT_EQ(polygon_geometry_is_valid_for(&progress_polygon->geometry, 400, 400), TRUE);
+  if (progress_polygon->prepare_job != NULL) {
+    /*后台准备期间使用简化的形状*/
+    EXPECT_LT(progress_polygon->geometry.size, 1000);
+  }
+
+  polygon_worker_flush();
+  EXPECT_EQ(progress_polygon->prepare_job == NULL, TRUE);
+  ASSERT_EQ(progress_polygon->geometry.size, 1000);
+
+  ASSERT_EQ(resolve_polygon(&expected, polygon, 400, 400), RET_OK);
+  EXPECT_EQ(memcmp(progress_polygon->geometry.values, expected.values,
+                   expected.size * 5 * sizeof(float)),
+            0);
+
+  polygon_geometry_deinit(&expected);
+  widget_destroy(w);
+  TKMEM_FREE(polygon);
+}
+
+TEST(progress_polygon, async_swap_race) {
+  uint32_t i = 0;
+  uint32_t round = 0;
+  uint32_t n = 8;
+  widget_t* widgets[8];
+  char* polygon = make_arc_polygon(1000, 100, 150);
+
+  for (i = 0; i < n; i++) {
+    widgets[i] = progress_polygon_create(NULL, 0, 0, 400, 400);
+    progress_polygon_set_editable(widgets[i], (i % 2) == 0);
+    progress_polygon_set_polygon(widgets[i], polygon);
+  }
+
+  /*不断改变大小，让新任务取代还在执行的任务，并在任意时刻分发完成的任务*/
+  for (round = 0; round < 50; round++) {
+    for (i = 0; i < n; i++) {
+      widget_resize(widgets[i], 200 + (round * 7 + i * 13) % 200, 200 + (round * 11 + i) % 200);
+      progress_polygon_prewarm(widgets[i]);
+    }
+
+    if (round % 3 == 0) {
+      polygon_worker_dispatch();
+    }
+
+    /*过期的结果不会被替换进来*/
+    for (i = 0; i < n; i++) {
+      progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widgets[i]);
+      EXPECT_EQ(polygon_geometry_is_valid_for(&progress_polygon->geometry, widgets[i]->w,
+                                              widgets[i]->h),
+                TRUE);
+    }
+  }
+
+  /*任务完成的同时不断点击测试，结果在分发时才替换进来，点击测试总是看到完整的数据*/
+  /*只点击可编辑的控件，不可编辑的控件点击测试时才会建立网格，后面要检查任务没有建立网格*/
+  while (polygon_worker_get_pending() > 0) {
+    for (i = 0; i < n; i += 2) {
+      double value = 0;
+      widget_t* w = widgets[i];
+      ret_t ret = progress_polygon_get_value_at(w, w->w / 2, w->h / 10, &value);
+
+      EXPECT_EQ(ret == RET_OK || ret == RET_NOT_FOUND, TRUE);
+      if (ret == RET_OK) {
+        EXPECT_GE(value, 0);
+        EXPECT_LE(value, 100);
+      }
+    }
+    polygon_worker_dispatch();
+  }
+
+  /*任务还在执行时销毁控件*/
+  widget_destroy(widgets[0]);
+  polygon_worker_flush();
+  EXPECT_EQ(polygon_worker_get_pending(), 0);
+
+  for (i = 1; i < n; i++) {
+    polygon_geometry_t expected;
+    progress_polygon_t* progress_polygon = PROGRESS_POLYGON(widgets[i]);
+
+    EXPECT_EQ(progress_polygon->prepare_job == NULL, TRUE);
+    ASSERT_EQ(resolve_polygon(&expected, polygon, widgets[i]->w, widgets[i]->h), RET_OK);
+    ASSERT_EQ(progress_polygon->geometry.size, expected.size);
+    EXPECT_EQ(memcmp(progress_polygon->geometry.values, expected.values,
+                     expected.size * 5 * sizeof(float)),
+              0);
+    EXPECT_EQ(progress_polygon->hit_grid == NULL, (i % 2) != 0);
+
+    polygon_geometry_deinit(&expected);
+    widget_destroy(widgets[i]);
+  }
+
+  TKMEM_FREE(polygon);
+}
+
+typedef struct _test_job_t {
+  polygon_job_t job;
+  tk_mutex_t* gate;
+  uint32_t run_nr;
+  uint32_t done_nr;
+} test_job_t;
+
+static ret_t test_job_run(polygon_job_t* job) {
+  test_job_t* test = (test_job_t*)job;
+
+  if (test->gate != NULL) {
+    tk_mutex_lock(test->gate);
+    tk_mutex_unlock(test->gate);
+  }
+  test->run_nr++;
+
+  return RET_OK;
+}
+
+static ret_t test_job_on_done(polygon_job_t* job) {
+  ((test_job_t*)job)->done_nr++;
+
+  return RET_OK;
+}
+
+TEST(progress_polygon, worker_cancel) {
+  uint32_t i = 0;
+  test_job_t busy[POLYGON_WORKER_THREAD_NR];
+  test_job_t canceled;
+  tk_mutex_t* gate = tk_mutex_create();
+
+  ASSERT_EQ(gate != NULL, TRUE);
+  memset(busy, 0x00, sizeof(busy));
+  memset(&canceled, 0x00, sizeof(canceled));
+
+  /*让所有后台线程都忙着，取消排在后面的任务*/
+  tk_mutex_lock(gate);
+  for (i = 0; i < POLYGON_WORKER_THREAD_NR; i++) {
+    busy[i].job.run = test_job_run;
+    busy[i].job.on_done = test_job_on_done;
+    busy[i].gate = gate;
+    ASSERT_EQ(polygon_worker_submit(&busy[i].job), RET_OK);
+  }
+  canceled.job.run = test_job_run;
+  canceled.job.on_done = test_job_on_done;
+  ASSERT_EQ(polygon_worker_submit(&canceled.job), RET_OK);
+  ASSERT_EQ(polygon_worker_cancel(&canceled.job), RET_OK);
+  tk_mutex_unlock(gate);
+
+  polygon_worker_flush();
+  for (i = 0; i < POLYGON_WORKER_THREAD_NR; i++) {
+    EXPECT_EQ(busy[i].run_nr, 1u);
+    EXPECT_EQ(busy[i].done_nr, 1u);
+  }
+  EXPECT_EQ(canceled.run_nr, 0u);
+  EXPECT_EQ(canceled.done_nr, 1u);
+
+  tk_mutex_destroy(gate);
+}
+
+TEST(progress_polygon, band) {
+  rect_t r;
+  polygon_geometry_t geo;
+
+  ASSERT_EQ(resolve_polygon(&geo, "(0, 0,0,0,1)(0.5, 0.5,0.2,0.5,1)(1, 1,0,1,1)", 200, 10),
+            RET_OK);
+
+  EXPECT_EQ(polygon_geometry_get_band(&geo, 0.1, 0.2, &r), RET_OK);
+  EXPECT_EQ(r.x, 19);
+  EXPECT_EQ(r.w, 22);
+
+  /*跨过中间的点时包含它*/
+  EXPECT_EQ(polygon_geometry_get_band(&geo, 0.75, 0.25, &r), RET_OK);
+  EXPECT_EQ(r.x, 49);
+  EXPECT_EQ(r.w, 102);
+  EXPECT_EQ(r.y, 0);
+  EXPECT_EQ(r.h, 11);
+
+  polygon_geometry_deinit(&geo);
+}
+
+TEST(progress_polygon, value_animation) {
+  value_t v;
+  widget_t* w = progress_polygon_create(NULL, 10, 20, 100, 40);
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(w);
+
+  progress_polygon_set_polygon(w, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  EXPECT_EQ(widget_set_prop_str(w, PROGRESS_POLYGON_PROP_VALUE_ANIMATION,
+                                "duration=300, easing=sin_out"),
+            RET_OK);
+  EXPECT_EQ(progress_polygon->anim_cfg_duration, 300);
+  EXPECT_EQ(progress_polygon->anim_cfg_easing, EASING_SIN_OUT);
+  EXPECT_EQ(widget_get_prop(w, PROGRESS_POLYGON_PROP_VALUE_ANIMATION, &v), RET_OK);
+  EXPECT_STREQ(value_str(&v), "duration=300, easing=sin_out");
+
+  /*value 属性总是立即生效，也不会提前解析多边形*/
+  EXPECT_EQ(widget_set_prop_int(w, PROGRESS_POLYGON_PROP_VALUE, 20), RET_OK);
+  EXPECT_EQ(widget_get_prop_int(w, PROGRESS_POLYGON_PROP_VALUE, 0), 20);
+  EXPECT_EQ(progress_polygon->anim == NULL, TRUE);
+
+  /*animate_to 属性使用内置动画，读取时返回目标值*/
+  EXPECT_EQ(widget_set_prop_int(w, PROGRESS_POLYGON_PROP_ANIMATE_TO, 80), RET_OK);
+  ASSERT_EQ(progress_polygon->anim != NULL, TRUE);
+  EXPECT_NE(progress_polygon->anim->timer_id, TK_INVALID_ID);
+  EXPECT_EQ(progress_polygon->anim->to, 80);
+  EXPECT_EQ(progress_polygon->anim->duration, 300);
+  EXPECT_EQ(progress_polygon->anim->easing, EASING_SIN_OUT);
+  EXPECT_EQ(progress_polygon->value, 20);
+  EXPECT_EQ(progress_polygon->geometry.size, 0);
+  EXPECT_EQ(widget_get_prop_int(w, PROGRESS_POLYGON_PROP_ANIMATE_TO, 0), 80);
+
+  /*直接设置会停止动画*/
+  EXPECT_EQ(widget_set_prop_int(w, PROGRESS_POLYGON_PROP_VALUE, 30), RET_OK);
+  EXPECT_EQ(progress_polygon->anim == NULL, TRUE);
+  EXPECT_EQ(progress_polygon->value, 30);
+  EXPECT_EQ(widget_get_prop_int(w, PROGRESS_POLYGON_PROP_ANIMATE_TO, 0), 30);
+
+  /*边界移动不到 1 像素时不需要动画*/
+  EXPECT_EQ(progress_polygon_prewarm(w), RET_OK);
+  EXPECT_EQ(progress_polygon_animate_to(w, 30.5, 300, EASING_LINEAR), RET_OK);
+  EXPECT_EQ(progress_polygon->anim == NULL, TRUE);
+  EXPECT_EQ(progress_polygon->value, 30.5);
+
+  EXPECT_EQ(progress_polygon_animate_to(w, 60, 0, EASING_LINEAR), RET_OK);
+  EXPECT_EQ(progress_polygon->value, 60);
+
+  progress_polygon_set_value_animation(w, NULL);
+  EXPECT_EQ(progress_polygon->anim_cfg_duration, 0);
+  EXPECT_EQ(widget_set_prop_int(w, PROGRESS_POLYGON_PROP_ANIMATE_TO, 10), RET_OK);
+  EXPECT_EQ(progress_polygon->anim == NULL, TRUE);
+  EXPECT_EQ(progress_polygon->value, 10);
+
+  widget_destroy(w);
+}
+
+TEST(progress_polygon, range) {
+  uint32_t from_offset = 0;
+  uint32_t to_offset = 0;
+  polygon_point_t from;
+  polygon_point_t to;
+  polygon_geometry_t geo;
+
+  ASSERT_EQ(resolve_polygon(&geo, "(0, 0,0,0,1)(0.5, 0.5,0,0.5,1)(1, 1,0,1,1)", 200, 10), RET_OK);
+
+  EXPECT_EQ(polygon_geometry_get_range(&geo, 0.25, 0.75, &from_offset, &from, &to_offset, &to),
+            RET_OK);
+  EXPECT_EQ(from_offset, 1);
+  EXPECT_EQ(from.x1, 50);
+  EXPECT_EQ(to_offset, 2);
+  EXPECT_EQ(to.x1, 150);
+
+  /*与分别查找的结果相同*/
+  EXPECT_EQ(polygon_geometry_get_range(&geo, 0.5, 0.5, &from_offset, &from, &to_offset, &to),
+            RET_OK);
+  EXPECT_EQ(from_offset, 1);
+  EXPECT_EQ(to_offset, 1);
+  EXPECT_EQ(to.x1, 100);
+
+  EXPECT_EQ(polygon_geometry_get_range(&geo, 0, 1, &from_offset, &from, &to_offset, &to), RET_OK);
+  EXPECT_EQ(from_offset, 0);
+  EXPECT_EQ(from.x1, 0);
+  EXPECT_EQ(to_offset, 2);
+  EXPECT_EQ(to.x2, 200);
+
+  EXPECT_NE(polygon_geometry_get_range(&geo, 0.8, 0.2, &from_offset, &from, &to_offset, &to),
+            RET_OK);
+
+  polygon_geometry_deinit(&geo);
+}
+
+TEST(progress_polygon, start_value) {
+  value_t v;
+  widget_t* w = progress_polygon_create(NULL, 10, 20, 100, 40);
+  progress_polygon_t* progress_polygon = PROGRESS_POLYGON(w);
+
+  EXPECT_EQ(progress_polygon->start_value, 0);
+  EXPECT_EQ(widget_set_prop_int(w, PROGRESS_POLYGON_PROP_START_VALUE, 20), RET_OK);
+  EXPECT_EQ(progress_polygon->start_value, 20);
+  EXPECT_EQ(widget_get_prop(w, PROGRESS_POLYGON_PROP_START_VALUE, &v), RET_OK);
+  EXPECT_EQ(value_double(&v), 20);
+
+  progress_polygon_set_polygon(w, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  EXPECT_EQ(progress_polygon_prewarm(w), RET_OK);
+  EXPECT_EQ(progress_polygon_set_start_value(w, 40), RET_OK);
+  EXPECT_EQ(progress_polygon->start_value, 40);
+
+  widget_destroy(w);
+}
+
+TEST(progress_polygon, batch) {
+  uint32_t i = 0;
+  polygon_batch_t batch;
+  polygon_geometry_t geo[2];
+  double values[] = {-10, 0, 20, 25, 50, 70, 100, 120};
+  uint32_t n = ARRAY_SIZE(values);
+
+  ASSERT_EQ(resolve_polygon(&geo[0], "(0, 0,0,0,1)(0.5, 0.5,0,0.5,1)(1, 1,0,1,1)", 200, 10),
+            RET_OK);
+  ASSERT_EQ(resolve_polygon(&geo[1], "(0, 0,0,0,1)(0.2, 0.1,0,0.1,1)(0.2, 0.3,0,0.3,1)(1, 1,0,1,1)",
+                            150, 20),
+            RET_OK);
+
+  polygon_batch_init(&batch);
+  ASSERT_EQ(polygon_batch_reset(&batch, n * n), RET_OK);
+  for (i = 0; i < n * n; i++) {
+    EXPECT_EQ(polygon_batch_add(&batch, &geo[i % 2], values[i / n], values[i % n], 0, 100), RET_OK);
+  }
+  EXPECT_NE(polygon_batch_add(&batch, &geo[0], 0, 0, 0, 100), RET_OK);
+  EXPECT_EQ(polygon_batch_compute(&batch), RET_OK);
+
+  /*与逐个调用 polygon_geometry_get_range 的结果完全相同*/
+  for (i = 0; i < n * n; i++) {
+    uint32_t from_offset = 0;
+    uint32_t to_offset = 0;
+    uint32_t batch_from_offset = 0;
+    uint32_t batch_to_offset = 0;
+    polygon_point_t from, to, batch_from, batch_to;
+    double a = tk_clamp(values[i / n], 0, 100) / 100;
+    double b = tk_clamp(values[i % n], 0, 100) / 100;
+
+    polygon_geometry_get_range(&geo[i % 2], tk_min(a, b), tk_max(a, b), &from_offset, &from,
+                               &to_offset, &to);
+    EXPECT_EQ(polygon_batch_get_range(&batch, i, &batch_from_offset, &batch_from, &batch_to_offset,
+                                      &batch_to),
+              RET_OK);
+    EXPECT_EQ(batch_from_offset, from_offset);
+    EXPECT_EQ(batch_to_offset, to_offset);
+    EXPECT_EQ(memcmp(&batch_from, &from, sizeof(from)), 0);
+    EXPECT_EQ(memcmp(&batch_to, &to, sizeof(to)), 0);
+  }
+
+  /*容量足够时只清空*/
+  EXPECT_EQ(polygon_batch_reset(&batch, 4), RET_OK);
+  EXPECT_EQ(batch.size, 0);
+  EXPECT_EQ(batch.capacity, n * n);
+
+  polygon_batch_deinit(&batch);
+  polygon_geometry_deinit(&geo[0]);
+  polygon_geometry_deinit(&geo[1]);
+}
+
+TEST(progress_polygon, group) {
+  value_t v;
+  uint32_t batched = 0;
+  uint32_t styles = 0;
+  widget_t* group = progress_polygon_group_create(NULL, 0, 0, 400, 300);
+
+  progress_polygon_create(group, 10, 20, 100, 40);
+  EXPECT_EQ(progress_polygon_group_cast(group), group);
+  EXPECT_EQ(widget_count_children(group), 1);
+  EXPECT_TRUE(PROGRESS_POLYGON_GROUP(group)->batch);
+
+  EXPECT_EQ(widget_set_prop_bool(group, PROGRESS_POLYGON_GROUP_PROP_BATCH, FALSE), RET_OK);
+  EXPECT_EQ(widget_get_prop(group, PROGRESS_POLYGON_GROUP_PROP_BATCH, &v), RET_OK);
+  EXPECT_FALSE(value_bool(&v));
+  EXPECT_EQ(progress_polygon_group_set_batch(group, TRUE), RET_OK);
+  EXPECT_TRUE(PROGRESS_POLYGON_GROUP(group)->batch);
+
+  /*还没有绘制过*/
+  EXPECT_EQ(progress_polygon_group_get_stat(group, &batched, &styles), RET_OK);
+  EXPECT_EQ(batched, 0);
+  EXPECT_EQ(styles, 0);
+
+  widget_destroy(group);
+}
+
+static widget_t* group_add_gauge(widget_t* group, xy_t x, xy_t y, double value, uint32_t fg_color,
+                                 uint32_t border_color) {
+  widget_t* gauge = progress_polygon_create(group, x, y, 80, 30);
+
+  widget_set_style_color(gauge, "normal:fg_color", fg_color);
+  widget_set_style_color(gauge, "normal:bg_color", 0xff808080);
+  widget_set_style_color(gauge, "normal:border_color", border_color);
+  widget_set_style_int(gauge, "normal:border_width", 2);
+  progress_polygon_set_polygon(gauge, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  progress_polygon_set_value(gauge, value);
+  progress_polygon_prewarm(gauge);
+
+  return gauge;
+}
+
+static void group_render(widget_t* group, uint8_t* pixels, wh_t w, wh_t h) {
+  canvas_t c;
+  rect_t r = rect_init(0, 0, w, h);
+  lcd_t* lcd = lcd_mem_bgra8888_create_single_fb(w, h, pixels);
+
+  canvas_init(&c, lcd, font_manager());
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  canvas_set_fill_color(&c, color_init(0xff, 0xff, 0xff, 0xff));
+  canvas_fill_rect(&c, 0, 0, w, h);
+  widget_paint(group, &c);
+  canvas_end_frame(&c);
+
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
+
+static bool_t group_pixel_is(const uint8_t* pixels, wh_t w, xy_t x, xy_t y, uint8_t r, uint8_t g,
+                             uint8_t b) {
+  const uint8_t* p = pixels + (y * w + x) * 4;
+
+  return p[0] == b && p[1] == g && p[2] == r;
+}
+
+TEST(progress_polygon, group_paint) {
+  uint32_t i = 0;
+  uint32_t diff = 0;
+  uint32_t batched = 0;
+  uint32_t styles = 0;
+  wh_t w = 200;
+  wh_t h = 100;
+  uint8_t* batch_pixels = TKMEM_ZALLOCN(uint8_t, w * h * 4);
+  uint8_t* plain_pixels = TKMEM_ZALLOCN(uint8_t, w * h * 4);
+  widget_t* win = window_create(NULL, 0, 0, w, h);
+  widget_t* group = progress_polygon_group_create(win, 0, 0, w, h);
+  widget_t* view = NULL;
+  ASSERT_TRUE(batch_pixels != NULL && plain_pixels != NULL);
+
+  /*普通控件压在第一个进度条上面，又被第二个进度条压住，第三个进度条使用另外一种样式*/
+  group_add_gauge(group, 10, 10, 50, 0xff0000ff, 0x00000000);
+  view = view_create(group, 50, 20, 80, 40);
+  widget_set_style_color(view, "normal:bg_color", 0xffff0000);
+  group_add_gauge(group, 100, 30, 25, 0xff0000ff, 0x00000000);
+  group_add_gauge(group, 10, 60, 75, 0xff00ff00, 0xff000000);
+  polygon_worker_flush();
+
+  ASSERT_EQ(progress_polygon_group_set_batch(group, TRUE), RET_OK);
+  group_render(group, batch_pixels, w, h);
+  EXPECT_EQ(progress_polygon_group_get_stat(group, &batched, &styles), RET_OK);
+  EXPECT_EQ(batched, 3);
+  EXPECT_EQ(styles, 2);
+
+  ASSERT_EQ(progress_polygon_group_set_batch(group, FALSE), RET_OK);
+  group_render(group, plain_pixels, w, h);
+  EXPECT_EQ(progress_polygon_group_get_stat(group, &batched, &styles), RET_OK);
+  EXPECT_EQ(batched, 0);
+  EXPECT_EQ(styles, 0);
+
+  /*合并绘制与逐个绘制的结果相同*/
+  for (i = 0; i < (uint32_t)(w * h * 4); i++) {
+    if (tk_abs((int32_t)batch_pixels[i] - (int32_t)plain_pixels[i]) > 1) {
+      diff++;
+    }
+  }
+  EXPECT_EQ(diff, 0);
+
+  /*叠放次序: 普通控件在第一个进度条之上，在第二个进度条之下*/
+  EXPECT_TRUE(group_pixel_is(batch_pixels, w, 40, 25, 0xff, 0x00, 0x00));
+  EXPECT_TRUE(group_pixel_is(batch_pixels, w, 60, 25, 0x00, 0x00, 0xff));
+  EXPECT_TRUE(group_pixel_is(batch_pixels, w, 110, 45, 0xff, 0x00, 0x00));
+  EXPECT_TRUE(group_pixel_is(batch_pixels, w, 150, 45, 0x80, 0x80, 0x80));
+  EXPECT_TRUE(group_pixel_is(batch_pixels, w, 40, 75, 0x00, 0xff, 0x00));
+
+  widget_destroy(win);
+  TKMEM_FREE(batch_pixels);
+  TKMEM_FREE(plain_pixels);
+}
+
+TEST(progress_polygon, gradient_paint) {
+  wh_t w = 120;
+  wh_t h = 20;
+  uint8_t* pixels = TKMEM_ZALLOCN(uint8_t, w * h * 4);
+  widget_t* win = window_create(NULL, 0, 0, w, h);
+  widget_t* gauge = progress_polygon_create(win, 10, 0, 100, 20);
+  const uint8_t* p = NULL;
+  ASSERT_TRUE(pixels != NULL);
+
+  widget_set_style_str(gauge, "normal:fg_gradient", "#000000;#ffffff;#000000");
+  progress_polygon_set_polygon(gauge, "(0, 0,0,0,1)(0.3, 0.3,0,0.3,1)(0.7, 0.7,0,0.7,1)(1, 1,0,1,1)");
+  progress_polygon_set_value(gauge, 100);
+  ASSERT_EQ(progress_polygon_prewarm(gauge), RET_OK);
+  group_render(gauge, pixels, w, h);
+
+  /*每段只填充一次，颜色仍然在两个关键点之间连续变化*/
+  p = pixels + (10 * w + 11) * 4;
+  EXPECT_LT(p[0], 0x10);
+  p = pixels + (10 * w + 35) * 4;
+  EXPECT_NEAR(p[0], 0x80, 8);
+  EXPECT_NEAR(p[1], 0x80, 8);
+  p = pixels + (10 * w + 60) * 4;
+  EXPECT_GE(p[0], 0xf0);
+  p = pixels + (10 * w + 85) * 4;
+  EXPECT_NEAR(p[2], 0x80, 8);
+
+  widget_destroy(win);
+  TKMEM_FREE(pixels);
+}
+
+static rect_t s_invalidated;
+
+static ret_t band_probe_invalidate(widget_t* widget, const rect_t* r) {
+  rect_merge(&s_invalidated, r);
+
+  return RET_OK;
+}
+
+static widget_vtable_t s_band_probe_vtable;
+
+TEST(progress_polygon, start_value_range) {
+  xy_t x = 0;
+  wh_t w = 120;
+  wh_t h = 20;
+  uint8_t* pixels = TKMEM_ZALLOCN(uint8_t, w * h * 4);
+  widget_t* probe = NULL;
+  widget_t* gauge = NULL;
+  ASSERT_TRUE(pixels != NULL);
+
+  /*父控件记录子控件请求刷新的区域*/
+  s_band_probe_vtable.size = sizeof(widget_t);
+  s_band_probe_vtable.type = "band_probe";
+  s_band_probe_vtable.invalidate = band_probe_invalidate;
+  probe = widget_create(NULL, &s_band_probe_vtable, 0, 0, w, h);
+  gauge = progress_polygon_create(probe, 10, 0, 100, 20);
+
+  widget_set_style_color(gauge, "normal:fg_color", 0xff0000ff);
+  widget_set_style_color(gauge, "normal:bg_color", 0xff808080);
+  widget_set_style_int(gauge, "normal:border_width", 0);
+  progress_polygon_set_polygon(gauge, "(0, 0,0,0,1)(1, 1,0,1,1)");
+  progress_polygon_set_value(gauge, 60);
+  progress_polygon_set_start_value(gauge, 20);
+  ASSERT_EQ(progress_polygon_prewarm(gauge), RET_OK);
+
+  /*区间模式只在 start_value 和 value 之间绘制前景*/
+  group_render(gauge, pixels, w, h);
+  for (x = 12; x < 108; x++) {
+    bool_t fg = x >= 10 + 22 && x < 10 + 58;
+    bool_t bg = x < 10 + 18 || x >= 10 + 62;
+
+    if (fg) {
+      EXPECT_TRUE(group_pixel_is(pixels, w, x, 10, 0xff, 0x00, 0x00)) << "x=" << x;
+    } else if (bg) {
+      EXPECT_TRUE(group_pixel_is(pixels, w, x, 10, 0x80, 0x80, 0x80)) << "x=" << x;
+    }
+  }
+
+  /*修改 start_value 时刷新的区域同时包含旧的和新的起点*/
+  s_invalidated = rect_init(0, 0, 0, 0);
+  gauge->dirty = FALSE;
+  ASSERT_EQ(progress_polygon_set_start_value(gauge, 40), RET_OK);
+  EXPECT_LE(s_invalidated.x, 10 + 20);
+  EXPECT_GE(s_invalidated.x + s_invalidated.w, 10 + 40);
+  EXPECT_LT(s_invalidated.w, 100);
+
+  /*start_value 移到 value 的另一边，两端都要刷新*/
+  s_invalidated = rect_init(0, 0, 0, 0);
+  gauge->dirty = FALSE;
+  ASSERT_EQ(progress_polygon_set_start_value(gauge, 80), RET_OK);
+  EXPECT_LE(s_invalidated.x, 10 + 40);
+  EXPECT_GE(s_invalidated.x + s_invalidated.w, 10 + 80);
+
+  widget_destroy(probe);
+  TKMEM_FREE(pixels);
+}